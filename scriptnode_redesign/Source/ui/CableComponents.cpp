@@ -54,10 +54,36 @@ CableBase::~CableBase()
 bool CableBase::hitTest(int x, int y)
 {
 	Point<float> sp((float)x, (float)y);
+
+	if (!hitTestBounds.contains(sp))
+		return false;
+
 	Point<float> tp;
-	p.getNearestPoint(sp, tp);
 
-	return sp.getDistanceFrom(tp) < 5.0f;
+	for (size_t i = 0; i < segments.size(); i++)
+	{
+		if (segmentBounds[i].contains(sp) && segments[i].getDistanceFromPoint(sp, tp) < HitTestDistance)
+			return true;
+	}
+
+	return false;
+}
+
+void CableBase::updateHitTestSegments()
+{
+	segments.clear();
+	segmentBounds.clear();
+
+	PathFlatteningIterator it(p);
+
+	while (it.next())
+	{
+		Line<float> l(it.x1, it.y1, it.x2, it.y2);
+		segments.push_back(l);
+		segmentBounds.push_back(Rectangle<float>(l.getStart(), l.getEnd()).expanded(HitTestDistance));
+	}
+
+	hitTestBounds = p.getBounds().expanded(HitTestDistance);
 }
 
 void CableBase::changeListenerCallback(ChangeBroadcaster*)
@@ -93,33 +119,42 @@ void CableBase::rebuildPath(Point<float> newStart, Point<float> newEnd, Componen
 	s = getLocalPoint(parent, s);
 	e = getLocalPoint(parent, e);
 
+	createCablePath(p, arrow, s, e, offset);
+	updateHitTestSegments();
+
+	repaint();
+}
+
+void CableBase::createCablePath(Path& p, Path& arrow, Point<float> start, Point<float> end, float offset)
+{
 	p.clear();
-	Helpers::createCustomizableCurve(p, s, e.translated(-3.0f, 0.0f), offset);
+	Helpers::createCustomizableCurve(p, start, end.translated(-3.0f, 0.0f), offset);
 
 	arrow.clear();
-	arrow.startNewSubPath(e);
-	arrow.lineTo(e.translated(-7.0f, 5.0f));
-	arrow.lineTo(e.translated(-7.0f, -5.0f));
+	arrow.startNewSubPath(end);
+	arrow.lineTo(end.translated(-7.0f, 5.0f));
+	arrow.lineTo(end.translated(-7.0f, -5.0f));
 	arrow.closeSubPath();
-
-	repaint();
 }
 
 void CableBase::paint(Graphics& g)
 {
-	auto lod = LODManager::getLOD(*this);
+	drawCable(g, p, arrow, s, e, colour1, colour2, LODManager::getLOD(*this), over);
+}
 
-	if (colour1 == colour2)
-		g.setColour(colour1);
+void CableBase::drawCable(Graphics& g, const Path& p, const Path& arrow, Point<float> start, Point<float> end, Colour c1, Colour c2, int lod, bool over)
+{
+	if (c1 == c2)
+		g.setColour(c1);
 	else
-		g.setGradientFill(ColourGradient(colour1, s, colour2, e, false));
+		g.setGradientFill(ColourGradient(c1, start, c2, end, false));
 
 	auto strokeDepth = LayoutTools::getCableThickness(lod);
 
 	g.strokePath(p, PathStrokeType((over ? 3.0f : 1.0f) * strokeDepth));
 
 	if (lod == 0)
-		g.fillEllipse(Rectangle<float>(s, s).withSizeKeepingCentre(6.0f, 6.0f));
+		g.fillEllipse(Rectangle<float>(start, start).withSizeKeepingCentre(6.0f, 6.0f));
 
 	g.fillPath(arrow);
 }
@@ -185,7 +220,7 @@ void DraggedCable::paint(Graphics& g)
 	CableBase::paint(g);
 
 	auto f = GLOBAL_FONT();
-	auto w = f.getStringWidth(label) + 20.0f;
+	auto w = TextLayoutCache::getStringWidth(f, label) + 20.0f;
 
 	if (label.isNotEmpty() && getWidth() > w)
 	{
@@ -195,7 +230,7 @@ void DraggedCable::paint(Graphics& g)
 		g.fillRoundedRectangle(b, 3.0f);
 		g.setFont(f);
 		g.setColour(Colours::white.withAlpha(0.7f));
-		g.drawText(label, b, Justification::centred);
+		TextLayoutCache::drawText(g, label, b, Justification::centred);
 	}
 }
 
@@ -216,38 +251,13 @@ void DraggedCable::setTargetPosition(Point<int> rootPosition)
 
 	auto root = findParentComponentOfClass<DspNetworkComponent>();
 
-	CablePinBase* currentPin = nullptr;
-	ContainerComponent::AddButton* currentAddButton = nullptr;
+	if (dropTargets == nullptr)
+		dropTargets = new DropTargetIndex(root, src);
 
 	Rectangle<int> pinArea;
 
-	callRecursive<CablePinBase>(root, [&](CablePinBase* pin)
-	{
-		auto area = root->getLocalArea(pin, pin->getLocalBounds());
-
-		if (area.contains(rootPosition))
-		{
-			currentPin = pin;
-			pinArea = area;
-			return true;
-		}
-
-		return false;
-	});
-
-	callRecursive<ContainerComponent::AddButton>(root, [&](ContainerComponent::AddButton* b)
-	{
-		auto area = root->getLocalArea(b, b->getLocalBounds());
-
-		if(area.contains(rootPosition))
-		{
-			currentAddButton = b;
-			return true;
-		}
-			
-
-		return false;
-	});
+	auto currentPin = dropTargets->getPin(rootPosition, pinArea);
+	auto currentAddButton = dropTargets->getAddButton(rootPosition);
 
 	auto ne = rootPosition;
 	over = false;
@@ -305,6 +315,59 @@ void DraggedCable::setTargetPosition(Point<int> rootPosition)
 	rebuildPath(ns, ne.toFloat(), parent);
 }
 
+DraggedCable::DropTargetIndex::DropTargetIndex(Component* root, CablePinBase* src)
+{
+	callRecursive<CablePinBase>(root, [&](CablePinBase* pin)
+	{
+		// the source pin and pins that can't be a target are ignored by setTargetPosition() anyway
+		if (pin != src && pin->canBeTarget())
+		{
+			auto area = root->getLocalArea(pin, pin->getLocalBounds());
+			pinGrid.add(area, (int)pins.size());
+			pins.push_back({ pin, area });
+		}
+
+		return false;
+	});
+
+	callRecursive<ContainerComponent::AddButton>(root, [&](ContainerComponent::AddButton* b)
+	{
+		auto area = root->getLocalArea(b, b->getLocalBounds());
+		buttonGrid.add(area, (int)buttons.size());
+		buttons.push_back({ b, area });
+		return false;
+	});
+}
+
+CablePinBase* DraggedCable::DropTargetIndex::getPin(Point<int> rootPosition, Rectangle<int>& pinArea) const
+{
+	for (auto i : pinGrid.getCandidates(rootPosition))
+	{
+		const auto& p = pins[i];
+
+		if (p.pin != nullptr && p.area.contains(rootPosition))
+		{
+			pinArea = p.area;
+			return p.pin.get();
+		}
+	}
+
+	return nullptr;
+}
+
+ContainerComponent::AddButton* DraggedCable::DropTargetIndex::getAddButton(Point<int> rootPosition) const
+{
+	for (auto i : buttonGrid.getCandidates(rootPosition))
+	{
+		const auto& b = buttons[i];
+
+		if (b.button != nullptr && b.area.contains(rootPosition))
+			return b.button.getComponent();
+	}
+
+	return nullptr;
+}
+
 struct CableComponent::CableHolder::Stub : public SelectableComponent,
 	public CableBase
 {
@@ -323,7 +386,7 @@ struct CableComponent::CableHolder::Stub : public SelectableComponent,
 		originalTarget(target_),
 		attachment(attachment_)
 	{
-		auto targetPath = ParameterHelpers::getParameterPath(originalTarget->data);
+		auto targetPath = ParameterHelpers::getParameterPathIds(originalTarget->data);
 
 		colour1 = ParameterHelpers::getParameterColour(source->data);
 		colour2 = Helpers::getNodeColour(valuetree::Helpers::findParentWithType(originalTarget->data, PropertyIds::Node));
@@ -334,7 +397,7 @@ struct CableComponent::CableHolder::Stub : public SelectableComponent,
 			{
 				if (v.getType() == PropertyIds::Connection)
 				{
-					if (ParameterHelpers::getParameterPath(v) == targetPath)
+					if (ParameterHelpers::getParameterPathIds(v) == targetPath)
 					{
 						connection = v;
 						return true;
@@ -344,11 +407,22 @@ struct CableComponent::CableHolder::Stub : public SelectableComponent,
 				return false;
 			});
 
+		dynamic_cast<Component*>(&parent)->addChildComponent(this);
+		updatePosition();
+	}
+
+	/** Calculates the position from the pins. This is called again when the stub is reused by the next rebuild. */
+	void updatePosition()
+	{
 		auto w = GLOBAL_FONT().getStringWidth(getTextToDisplay()) + 20;
 		auto parentComponent = dynamic_cast<Component*>(&parent);
 
 		Point<float> start, end;
 
+		// make sure that the stub doesn't find itself when looking for stubs at the same position
+		textBounds = {};
+		offset = 0.0f;
+
 		if (attachment == Attachment::Source)
 		{
 			auto lp = parentComponent->getLocalArea(source, source->getLocalBounds());
@@ -370,9 +444,8 @@ struct CableComponent::CableHolder::Stub : public SelectableComponent,
 			start = end.translated(-50.0f, 0.0f);
 		}
 
-		dynamic_cast<Component*>(&parent)->addAndMakeVisible(this);
 		toBack();
-		rebuildPath(start, end, dynamic_cast<Component*>(&parent));
+		rebuildPath(start, end, parentComponent);
 		setSize(getWidth() + w, getHeight());
 
 		// Don't add cable for targets that are not visible
@@ -510,45 +583,54 @@ CableComponent::CableHolder::CableHolder(const ValueTree& v) :
 	hideConnectionListener.setCallback(v, { UIPropertyIds::HideCable }, Helpers::UIMode, VT_BIND_RECURSIVE_PROPERTY_LISTENER(onHideCable));
 
 	connectionListener.setCallback(v, Helpers::UIMode, VT_BIND_CHILD_LISTENER(onConnectionChange));
+
+#if SCRIPTNODE_BATCHED_CABLES
+	networkTree = v;
+#endif
+
 	initialised = true;
 }
 
+struct CableComponent::CableHolder::ConnectionSet
+{
+	struct StubInfo
+	{
+		CablePinBase* source;
+		CablePinBase* target;
+		Stub::Attachment attachment;
+	};
+
+	std::map<CablePinBase*, CablePinBase::Connections> cables;
+	std::vector<StubInfo> stubs;
+};
+
 void CableComponent::CableHolder::rebuildCables()
 {
 	if (!initialised)
 		return;
 
-	auto ok = false;
-
-	OwnedArray<CableComponent> newCables;
-
-	std::map<CablePinBase*, CablePinBase::Connections> allConnections;
-
-	Array<CablePinBase::WeakPtr> lockedRootSources;
+	ConnectionSet set;
 
 	auto asComponent = dynamic_cast<Component*>(this);
 
+	Component::callRecursive<ContainerComponentBase>(asComponent, [&](ContainerComponentBase* cc)
+	{
+		cc->rebuildOutsideParameters();
+		return false;
+	});
+
 	Component::callRecursive<ContainerComponentBase>(asComponent, [&](ContainerComponentBase* cc)
 	{
 		auto cTree = cc->asNodeComponent().getValueTree();
 		auto isRoot = Helpers::isRootNode(cTree);
 
-		cc->rebuildOutsideParameters();
-
 		auto isLockedRoot = isRoot && cTree.getParent().getType() != PropertyIds::Network;
 
+		// Force a cable for sources that are the root of a locked container
 		if (isLockedRoot)
 		{
 			for (int i = 0; i < cc->getNumOutsideParameters(); i++)
-			{
-				auto p = cc->getOutsideParameter(i);
-				auto con = p->rebuildConnections(asComponent);
-
-				if (!con.empty())
-					allConnections[p] = std::move(con);
-
-				lockedRootSources.addIfNotAlreadyThere(p);
-			}
+				addConnectionsForSource(set, cc->getOutsideParameter(i), true);
 		}
 
 		return false;
@@ -556,23 +638,14 @@ void CableComponent::CableHolder::rebuildCables()
 
 	Component::callRecursive<ModOutputComponent>(asComponent, [&](ModOutputComponent* mc)
 	{
-		auto con = mc->rebuildConnections(asComponent);
-
-		if (!con.empty())
-			allConnections[mc] = std::move(con);
-
+		addConnectionsForSource(set, mc, false);
 		return false;
 	});
 
 	Component::callRecursive<ProcessNodeComponent::RoutableSignalComponent>(asComponent, [&](ProcessNodeComponent::RoutableSignalComponent* rs)
 	{
 		if (!rs->canBeTarget())
-		{
-			auto con = rs->rebuildConnections(asComponent);
-
-			if (!con.empty())
-				allConnections[rs] = std::move(con);
-		}
+			addConnectionsForSource(set, rs, false);
 
 		return false;
 	});
@@ -580,205 +653,1012 @@ void CableComponent::CableHolder::rebuildCables()
 	Component::callRecursive<ContainerComponent>(asComponent, [&](ContainerComponent* c)
 	{
 		for (int i = 0; i < c->getNumParameters(); i++)
-		{
-			auto p = c->getDraggableParameterComponent(i);
-			
-			auto con = p->rebuildConnections(asComponent);
-
-			if (!con.empty())
-				allConnections[p] = std::move(con);
-		}
+			addConnectionsForSource(set, c->getDraggableParameterComponent(i), false);
 
 		return false;
 	});
 
+	applyConnections(set, [](CablePinBase*) { return true; });
+}
 
+void CableComponent::CableHolder::onConnectionChange(const ValueTree& v, bool wasAdded)
+{
+	if (!initialised)
+		return;
 
-	std::map<CablePinBase*, CablePinBase::Connections> localConnections;
-
-	stubs.clear();
+	// Hidden cables and connections to locked containers change the outside parameters of a container
+	if (v[UIPropertyIds::HideCable] || isLockedTarget(v))
+	{
+		rebuildCables();
+		return;
+	}
 
-	for (auto& c : allConnections)
+	if (wasAdded)
 	{
-		for (auto it = c.second.begin(); it != c.second.end();)
+		auto src = findCableSource(v);
+
+		if (src == nullptr)
 		{
-			CablePinBase* src = c.first;
-			CablePinBase* dst = *it;
+			rebuildCables();
+			return;
+		}
 
-			auto con = ParameterHelpers::getConnection(dst->data);
+		// this only recalculates the targets of the connection's source
+		ConnectionSet set;
+		addConnectionsForSource(set, src, false);
 
-			// Check whether to add a cable
-			auto shouldHide = con.isValid() && con[UIPropertyIds::HideCable];
+		applyConnections(set, [this, src](CablePinBase* s)
+		{
+			return s == nullptr || s == src || (s->data == src->data && isOutsideParameter(s));
+		});
 
-			// Force a cable for sources that are the root of a locked container
-			auto forceCable = lockedRootSources.contains(src);
+		return;
+	}
 
-			if (!forceCable && (shouldHide))
-			{
-				auto targetContainer = dst->findParentComponentOfClass<ContainerComponent>();
+	auto removedAny = false;
 
-				if (targetContainer != nullptr)
-				{
-					if (auto localSource = targetContainer->getOutsideParameter(c.first->data))
-					{
-						localConnections[localSource].push_back(dst);
+#if SCRIPTNODE_BATCHED_CABLES
+	if (cableLayer != nullptr)
+	{
+		if (cableLayer->isOutsideConnection(v))
+		{
+			rebuildCables();
+			return;
+		}
 
-						stubs.add(new Stub(*this, src, dst, Stub::Attachment::Source));
+		// this also deletes the proxy of the cable
+		removedAny = cableLayer->removeConnection(v);
+	}
+#endif
 
-						it = c.second.erase(it);
-						continue;
-					}
-				}
+	for (int i = 0; i < cables.size(); i++)
+	{
+		auto c = cables[i];
 
-				stubs.add(new Stub(*this, src, dst, Stub::Attachment::Source));
+		if (c->connectionTree != v)
+			continue;
 
-				stubs.add(new Stub(*this, src, dst, Stub::Attachment::Target));
+		if (isOutsideParameter(c->src) || isOutsideParameter(c->dst))
+		{
+			rebuildCables();
+			return;
+		}
 
-				it = c.second.erase(it);
-				continue;
-			}
+		cables.remove(i--);
+		removedAny = true;
+	}
 
-			++it;
+	if (removedAny)
+	{
+		// the labels of deleted cables have lost their attached cable
+		for (int i = 0; i < labels.size(); i++)
+		{
+			if (labels[i]->attachedCable.getComponent() == nullptr)
+				labels.remove(i--);
 		}
+
+		cablesRebuilt();
 	}
+}
 
-	allConnections.merge(localConnections);
+void CableComponent::CableHolder::addConnectionsForSource(ConnectionSet& set, CablePinBase* src, bool forceCable)
+{
+	if (src == nullptr)
+		return;
 
-	cables.clear();
-	labels.clear();
+	auto asComponent = dynamic_cast<Component*>(this);
 
-	for (const auto& c : allConnections)
+	for (auto& dst : src->rebuildConnections(asComponent))
 	{
-		auto src = c.first;
+		auto con = ParameterHelpers::getConnection(dst->data);
 
-		for (const auto& dst : c.second)
-		{
-			if (src->isFoldedAway() || dst->isFoldedAway())
-				continue;
+		// Check whether to add a cable
+		auto shouldHide = con.isValid() && con[UIPropertyIds::HideCable];
 
-			auto asLasso = dynamic_cast<SelectableComponent::Lasso*>(this);
-
-			auto nc = new CableComponent(*asLasso, src, dst);
-
-			cables.add(nc);
-			asComponent->addAndMakeVisible(nc);
+		if (!forceCable && shouldHide)
+		{
+			set.stubs.push_back({ src, dst.get(), Stub::Attachment::Source });
 
-			//auto sourceVisible = !Helpers::isFoldedRecursive(src->getNodeTree());
-			//auto targetVisible = !Helpers::isFoldedRecursive(dst->getNodeTree());
+			if (auto targetContainer = dst->findParentComponentOfClass<ContainerComponent>())
+			{
+				if (auto localSource = targetContainer->getOutsideParameter(src->data))
+				{
+					set.cables[localSource].push_back(dst);
+					continue;
+				}
+			}
 
-			//nc->setVisible(sourceVisible && targetVisible);
+			set.stubs.push_back({ src, dst.get(), Stub::Attachment::Target });
+			continue;
+		}
 
-			nc->updatePosition({}, {});
+		set.cables[src].push_back(dst);
+	}
+}
 
-			nc->colour1 = ParameterHelpers::getParameterColour(src->data);
+void CableComponent::CableHolder::applyConnections(ConnectionSet& set, const std::function<bool(CablePinBase*)>& isAffected)
+{
+	auto asComponent = dynamic_cast<Component*>(this);
 
-			auto n = dst->data;
+	// Keep the stubs that are still required (along with their selection state) and update their position
+	for (int i = 0; i < stubs.size(); i++)
+	{
+		auto st = dynamic_cast<Stub*>(stubs[i]);
 
-			if (n.getType() != PropertyIds::Node)
-				n = Helpers::findParentNode(n);
+		if (!isAffected(st->source.get()))
+			continue;
 
-			nc->colour2 = Helpers::getNodeColour(n);
+		auto it = std::find_if(set.stubs.begin(), set.stubs.end(), [st](const ConnectionSet::StubInfo& si)
+		{
+			return si.source == st->source.get() && si.target == st->originalTarget.get() && si.attachment == st->attachment;
+		});
 
-			nc->toBack();
+		if (it != set.stubs.end())
+		{
+			set.stubs.erase(it);
+			st->updatePosition();
 		}
+		else
+			stubs.remove(i--);
 	}
 
-	for (auto c : cables)
+	for (const auto& si : set.stubs)
+		stubs.add(new Stub(*this, si.source, si.target, si.attachment));
+
+#if SCRIPTNODE_BATCHED_CABLES
+	if (cableLayer == nullptr)
 	{
-		asComponent->addChildComponent(labels.add(new CableLabel(c)));
-		labels.getLast()->updatePosition();
+		cableLayer = new CableLayer(*this, networkTree);
+		asComponent->addAndMakeVisible(cableLayer);
 	}
-}
 
-CableComponent::CableLabel::CableLabel(CableComponent* c) :
-	ComponentMovementWatcher(c),
-	attachedCable(c),
-	currentText(attachedCable->getLabelText())
-{
-	auto w = GLOBAL_FONT().getStringWidth(currentText) + 10;
-	setSize(w, 20);
-	updatePosition();
-}
+	cableLayer->setBounds(asComponent->getLocalBounds());
+	cableLayer->toBack();
+	cableLayer->applyConnections(set, isAffected);
+#else
+	// Only remove the cables that are not part of the new connection set and keep the
+	// other components (along with their selection & hover state).
+	for (int i = 0; i < cables.size(); i++)
+	{
+		auto c = cables[i];
 
-void CableComponent::CableLabel::updatePosition()
-{
-	if (attachedCable.getComponent() != nullptr)
+		if (!isAffected(c->src.get()))
+			continue;
+
+		if (takeConnection(set, c->src, c->dst, c->connectionTree))
+			c->updatePosition({}, {});
+		else
+			cables.remove(i--);
+	}
+
+	// the labels of deleted cables have lost their attached cable
+	for (int i = 0; i < labels.size(); i++)
 	{
-		setVisible((attachedCable->getWidth() > 300 || attachedCable->getHeight() > 500) && attachedCable->isVisible());
+		if (labels[i]->attachedCable.getComponent() == nullptr)
+			labels.remove(i--);
+	}
 
-		auto holder = dynamic_cast<Component*>(attachedCable->findParentComponentOfClass<CableHolder>());
+	for (const auto& c : set.cables)
+	{
+		auto src = c.first;
 
-		if (holder != nullptr)
+		for (const auto& dst : c.second)
 		{
-			auto pos = holder->getLocalPoint(attachedCable, attachedCable->e.toInt());
-			pos = pos.translated(-20, -10);
-			setTopRightPosition(pos.getX(), pos.getY());
+			if (src->isFoldedAway() || dst->isFoldedAway())
+				continue;
+
+			auto nc = createCable(src, dst);
+
+			asComponent->addChildComponent(labels.add(new CableLabel(nc)));
+			labels.getLast()->updatePosition();
 		}
 	}
+#endif
+
+	cablesRebuilt();
 }
 
-void CableComponent::CableLabel::componentVisibilityChanged()
+CableComponent* CableComponent::CableHolder::createCable(CablePinBase* src, CablePinBase* dst)
 {
-	triggerAsyncUpdate();
+	auto asComponent = dynamic_cast<Component*>(this);
+	auto asLasso = dynamic_cast<SelectableComponent::Lasso*>(this);
+
+	auto nc = cables.add(new CableComponent(*asLasso, src, dst));
+
+	asComponent->addAndMakeVisible(nc);
+	nc->updatePosition({}, {});
+
+	auto colours = getCableColours(src, dst);
+	nc->colour1 = colours.first;
+	nc->colour2 = colours.second;
+
+	nc->toBack();
+	return nc;
 }
 
-void CableComponent::CableLabel::paint(Graphics& g)
+bool CableComponent::CableHolder::takeConnection(ConnectionSet& set, CablePinBase* src, CablePinBase* dst, const ValueTree& connectionTree)
 {
-	LODManager::LODGraphics lg(g, *this);
+	if (src == nullptr || dst == nullptr)
+		return false;
 
-	if (attachedCable.getComponent() != nullptr)
-	{
-		g.setFont(GLOBAL_FONT());
-		g.setColour(Colour(0xdd222222));
+	auto it = set.cables.find(src);
 
-		lg.fillRoundedRectangle(getLocalBounds().toFloat(), (float)getHeight() * 0.5f);
-		g.setColour(attachedCable->colour2);
-		lg.drawText(currentText, getLocalBounds().toFloat().reduced(5.0f, 0.0f), Justification::right);
-	}
+	if (it == set.cables.end())
+		return false;
+
+	auto& targets = it->second;
+	auto d = std::find(targets.begin(), targets.end(), dst);
+
+	if (d == targets.end() || src->isFoldedAway() || dst->isFoldedAway() ||
+		connectionTree.getParent() != src->getConnectionTree())
+		return false;
+
+	// the cable already exists, so remove it from the list of cables to create
+	targets.erase(d);
+	return true;
 }
 
-CableComponent::CableHolder::Blinker::Blinker(CableHolder& p) :
-	parent(p)
+std::pair<Colour, Colour> CableComponent::CableHolder::getCableColours(CablePinBase* src, CablePinBase* dst)
 {
+	auto n = dst->data;
+
+	if (n.getType() != PropertyIds::Node)
+		n = Helpers::findParentNode(n);
 
+	return { ParameterHelpers::getParameterColour(src->data), Helpers::getNodeColour(n) };
 }
 
-void CableComponent::CableHolder::Blinker::blink(WeakReference<CablePinBase> target)
+CablePinBase* CableComponent::CableHolder::findCableSource(const ValueTree& connection)
 {
-	if (target == nullptr)
-		return;
+	auto conParent = connection.getParent();
+	auto ni = NetworkIndex::getFor(conParent);
 
-	for (auto& s : blinkTargets)
+	if (!conParent.isValid() || ni == nullptr)
+		return nullptr;
+
+	auto asComponent = dynamic_cast<Component*>(this);
+
+	for (auto p : ni->pins.getPinsForNode(Helpers::findParentNode(conParent)))
 	{
-		if (s.first == target)
+		if (p->getConnectionTree() != conParent || !asComponent->isParentOf(p) || isOutsideParameter(p))
+			continue;
+
+		if (p->findParentComponentOfClass<NodeComponent::PopupComponent>() != nullptr)
+			continue;
+
+		// only use the pins that rebuildCables() uses as source
+		if (dynamic_cast<ModOutputComponent*>(p) != nullptr)
+			return p;
+
+		if (auto rs = dynamic_cast<ProcessNodeComponent::RoutableSignalComponent*>(p))
 		{
-			s.second = 10;
-			startTimer(15);
-			return;
+			if (!rs->canBeTarget())
+				return p;
+
+			continue;
+		}
+
+		if (auto c = p->findParentComponentOfClass<ContainerComponent>())
+		{
+			for (int i = 0; i < c->getNumParameters(); i++)
+			{
+				if (c->getDraggableParameterComponent(i) == p)
+					return p;
+			}
 		}
 	}
 
-	blinkTargets.add({ target, 10 });
-	startTimer(15);
+	return nullptr;
 }
 
-void CableComponent::CableHolder::Blinker::unblink(CablePinBase::WeakPtr target)
+bool CableComponent::CableHolder::isOutsideParameter(CablePinBase* p)
 {
-	if (target == nullptr)
-		return;
+	if (p == nullptr)
+		return false;
 
-	for (int i = 0; i < blinkTargets.size(); i++)
+	if (auto cc = p->findParentComponentOfClass<ContainerComponentBase>())
 	{
-		if (blinkTargets[i].first == target)
-			blinkTargets.remove(i--);
+		for (int i = 0; i < cc->getNumOutsideParameters(); i++)
+		{
+			if (cc->getOutsideParameter(i) == p)
+				return true;
+		}
 	}
 
-	target->setBlinkAlpha(0.0f);
+	return false;
 }
 
-void CableComponent::CableHolder::Blinker::timerCallback()
+bool CableComponent::CableHolder::isLockedTarget(const ValueTree& connection)
 {
-	for (auto& s : blinkTargets)
+	auto target = ParameterHelpers::getTarget(connection);
+
+	if (target.getType() != PropertyIds::Node)
+		target = Helpers::findParentNode(target);
+
+	for (auto n = Helpers::findParentNode(target); n.isValid(); n = Helpers::findParentNode(n))
+	{
+		if (n[PropertyIds::Locked])
+			return true;
+	}
+
+	return false;
+}
+
+#if SCRIPTNODE_BATCHED_CABLES
+CableComponent::CableHolder::CableLayer::CableLayer(CableHolder& h, const ValueTree& networkTree) :
+	SimpleTimer(dynamic_cast<SelectableComponent::Lasso&>(h).getUpdater(), false),
+	holder(h),
+	lasso(dynamic_cast<SelectableComponent::Lasso*>(&h))
+{
+	// the cables don't intercept the mouse, they are selected with the lasso
+	setInterceptsMouseClicks(false, false);
+
+	lasso->getLassoSelection().addChangeListener(this);
+
+	positionListener.setCallback(networkTree, UIPropertyIds::Helpers::getPositionIds(), Helpers::UIMode, VT_BIND_RECURSIVE_PROPERTY_LISTENER(onPositionChange));
+	offsetListener.setCallback(networkTree, { UIPropertyIds::CableOffset }, Helpers::UIMode, VT_BIND_RECURSIVE_PROPERTY_LISTENER(onCableOffset));
+}
+
+CableComponent::CableHolder::CableLayer::~CableLayer()
+{
+	// the lasso is destroyed first if the layer is deleted along with its holder
+	if (lasso != nullptr)
+		lasso->getLassoSelection().removeChangeListener(this);
+}
+
+void CableComponent::CableHolder::CableLayer::applyConnections(ConnectionSet& set, const std::function<bool(CablePinBase*)>& isAffected)
+{
+	for (auto& r : records)
+	{
+		if (!r.alive || !isAffected(r.src.get()))
+			continue;
+
+		if (takeConnection(set, r.src, r.dst, r.connectionTree))
+		{
+			updatePath(r, false);
+
+			if (r.proxy != nullptr)
+				r.proxy->updatePosition({}, {});
+		}
+		else
+			removeRecord(r);
+	}
+
+	for (const auto& c : set.cables)
+	{
+		for (const auto& dst : c.second)
+		{
+			if (!c.first->isFoldedAway() && !dst->isFoldedAway())
+				addRecord(c.first, dst);
+		}
+	}
+
+	compact();
+}
+
+bool CableComponent::CableHolder::CableLayer::isOutsideConnection(const ValueTree& connection) const
+{
+	for (const auto& r : records)
+	{
+		if (r.alive && r.connectionTree == connection && (isOutsideParameter(r.src) || isOutsideParameter(r.dst)))
+			return true;
+	}
+
+	return false;
+}
+
+bool CableComponent::CableHolder::CableLayer::removeConnection(const ValueTree& connection)
+{
+	auto removedAny = false;
+
+	for (auto& r : records)
+	{
+		if (r.alive && r.connectionTree == connection)
+		{
+			removeRecord(r);
+			removedAny = true;
+		}
+	}
+
+	if (removedAny)
+		compact();
+
+	return removedAny;
+}
+
+void CableComponent::CableHolder::CableLayer::findLassoItems(Array<SelectableComponent::WeakPtr>& itemsFound, Rectangle<int> area)
+{
+	Line<float> diagonal(area.getTopLeft().toFloat(), area.getBottomRight().toFloat());
+
+	for (auto i : getGrid().getCandidates(area))
+	{
+		auto& r = records[i];
+
+		if (r.src == nullptr || r.dst == nullptr || !r.bounds.intersects(area))
+			continue;
+
+		if (r.p.intersectsLine(diagonal))
+			itemsFound.addIfNotAlreadyThere(getProxy(i));
+	}
+}
+
+void CableComponent::CableHolder::CableLayer::selectConnections(const Array<ValueTree>& connections)
+{
+	auto& selection = lasso->getLassoSelection();
+
+	for (int i = 0; i < (int)records.size(); i++)
+	{
+		if (connections.contains(records[i].connectionTree))
+			selection.addToSelection(getProxy(i));
+	}
+}
+
+void CableComponent::CableHolder::CableLayer::updateWatchers(Rectangle<int> newVisibleArea)
+{
+	visibleArea = newVisibleArea;
+
+	std::vector<int> stillWatched;
+	stillWatched.reserve(watchedRecords.size());
+
+	// only the watched cables can leave the area...
+	for (auto i : watchedRecords)
+	{
+		auto& r = records[i];
+
+		if (r.bounds.intersects(visibleArea))
+			stillWatched.push_back(i);
+		else
+			r.watcher = nullptr;
+	}
+
+	// ...and only the cables in the cells around the area can enter it
+	for (auto i : getGrid().getCandidates(visibleArea))
+	{
+		auto& r = records[i];
+
+		if (r.watcher != nullptr || r.dst == nullptr || !r.bounds.intersects(visibleArea))
+			continue;
+
+		if (r.dst->data.getType() != PropertyIds::Parameter)
+			continue;
+
+		if (auto ni = NetworkIndex::getFor(r.dst->data))
+		{
+			r.watcher.reset(new ValueWatcher(*this));
+
+			// this catches up with the current value without highlighting the change
+			auto v = ni->values.subscribe(r.watcher->subscription, r.dst->data, r.watcher.get(), lasso->getUpdater());
+			r.watcher->lastValue.setModValueIfChanged(v);
+
+			stillWatched.push_back(i);
+		}
+	}
+
+	watchedRecords = std::move(stillWatched);
+}
+
+void CableComponent::CableHolder::CableLayer::paint(Graphics& g)
+{
+	auto clip = g.getClipBounds();
+	auto lod = LODManager::getLOD(*this);
+	auto candidates = getGrid().getCandidates(clip);
+
+	for (auto i : candidates)
+	{
+		const auto& r = records[i];
+
+		// the selected cables are painted by their proxy
+		if (r.proxy != nullptr || r.src == nullptr || r.dst == nullptr || !clip.intersects(r.bounds))
+			continue;
+
+		CableBase::drawCable(g, r.p, r.arrow, r.s, r.e, r.colour1, r.colour2, lod, false);
+
+		if (r.watcher != nullptr && r.watcher->changeAlpha > 0)
+		{
+			auto alpha = (float)r.watcher->changeAlpha / 10.0f;
+			g.setColour(Colours::white.withAlpha(alpha));
+			g.strokePath(r.p, PathStrokeType(1.0f + alpha));
+			g.fillPath(r.arrow);
+		}
+	}
+
+	LODManager::LODGraphics lg(g, *this);
+
+	for (auto i : candidates)
+	{
+		const auto& r = records[i];
+
+		if (!r.labelArea.isEmpty() && r.src != nullptr && r.dst != nullptr && clip.intersects(r.labelArea))
+			CableLabel::draw(g, lg, r.labelArea.toFloat(), r.label, r.colour2);
+	}
+}
+
+void CableComponent::CableHolder::CableLayer::timerCallback()
+{
+	auto anyActive = false;
+
+	for (auto i : watchedRecords)
+	{
+		auto& r = records[i];
+
+		if (r.watcher->changeAlpha > 0)
+		{
+			r.watcher->changeAlpha--;
+			repaint(r.bounds);
+			anyActive |= r.watcher->changeAlpha > 0;
+		}
+	}
+
+	if (!anyActive)
+		stop();
+}
+
+void CableComponent::CableHolder::CableLayer::handleAsyncUpdate()
+{
+	if (positionsDirty)
+	{
+		positionsDirty = false;
+
+		for (auto& r : records)
+			updatePath(r, false);
+	}
+
+	auto& selection = lasso->getLassoSelection();
+
+	std::vector<int> stillSelected;
+
+	for (auto i : proxyRecords)
+	{
+		auto& r = records[i];
+
+		if (r.proxy != nullptr && selection.isSelected(r.proxy.getComponent()))
+		{
+			stillSelected.push_back(i);
+			continue;
+		}
+
+		holder.cables.removeObject(r.proxy.getComponent());
+		r.proxy = nullptr;
+		repaint(r.bounds);
+	}
+
+	proxyRecords = std::move(stillSelected);
+}
+
+void CableComponent::CableHolder::CableLayer::ValueWatcher::onParameterValue(double newValue)
+{
+	if (lastValue.setModValueIfChanged(newValue))
+	{
+		// the timer only runs while the change highlight fades out
+		changeAlpha = 11;
+		parent.start();
+	}
+}
+
+void CableComponent::CableHolder::CableLayer::addRecord(CablePinBase* src, CablePinBase* dst)
+{
+	Record r;
+	r.src = src;
+	r.dst = dst;
+	r.connectionTree = CableComponent::getConnectionTree(src, dst);
+	r.offset = (float)r.connectionTree[UIPropertyIds::CableOffset];
+	r.label = src->getSourceDescription();
+
+	auto colours = getCableColours(src, dst);
+	r.colour1 = colours.first;
+	r.colour2 = colours.second;
+
+	updatePath(r, true);
+	records.push_back(std::move(r));
+}
+
+void CableComponent::CableHolder::CableLayer::removeRecord(Record& r)
+{
+	if (r.proxy != nullptr)
+		holder.cables.removeObject(r.proxy.getComponent());
+
+	r.proxy = nullptr;
+	r.watcher = nullptr;
+	r.alive = false;
+
+	repaint(r.bounds.getUnion(r.labelArea));
+}
+
+void CableComponent::CableHolder::CableLayer::updatePath(Record& r, bool force)
+{
+	if (!r.alive || r.src == nullptr || r.dst == nullptr)
+		return;
+
+	auto asComponent = dynamic_cast<Component*>(&holder);
+
+	auto start = asComponent->getLocalArea(r.src, r.src->getLocalBounds()).toFloat();
+	auto end = asComponent->getLocalArea(r.dst, r.dst->getLocalBounds()).toFloat();
+
+	auto ns = Point<float>(start.getRight() - 3.0f, start.getCentreY());
+	auto ne = Point<float>(end.getX(), end.getCentreY()).translated(-1.0f * (float)Helpers::ParameterMargin, 0.0f);
+
+	// skip the path calculation if the pins haven't moved
+	if (!force && ns == r.s && ne == r.e)
+		return;
+
+	repaint(r.bounds.getUnion(r.labelArea));
+
+	r.s = ns;
+	r.e = ne;
+	CableBase::createCablePath(r.p, r.arrow, r.s, r.e, r.offset);
+
+	r.bounds = Rectangle<float>(r.s, r.e).toNearestInt().expanded(22);
+	r.labelArea = {};
+
+	if (CableLabel::shouldShowLabel(r.bounds))
+	{
+		auto w = roundToInt(TextLayoutCache::getStringWidth(GLOBAL_FONT(), r.label)) + 10;
+		auto topRight = r.e.toInt().translated(-20, -10);
+		r.labelArea = { topRight.getX() - w, topRight.getY(), w, 20 };
+	}
+
+	gridDirty = true;
+	repaint(r.bounds.getUnion(r.labelArea));
+}
+
+CableComponent* CableComponent::CableHolder::CableLayer::getProxy(int index)
+{
+	auto& r = records[index];
+
+	if (r.proxy == nullptr)
+	{
+		r.proxy = holder.createCable(r.src, r.dst);
+		proxyRecords.push_back(index);
+
+		// keep the layer behind the proxy
+		toBack();
+		repaint(r.bounds);
+	}
+
+	return r.proxy.getComponent();
+}
+
+void CableComponent::CableHolder::CableLayer::compact()
+{
+	std::vector<int> newIndexes(records.size(), -1);
+	int numAlive = 0;
+
+	for (int i = 0; i < (int)records.size(); i++)
+	{
+		if (!records[i].alive)
+			continue;
+
+		newIndexes[i] = numAlive;
+
+		if (i != numAlive)
+			records[numAlive] = std::move(records[i]);
+
+		numAlive++;
+	}
+
+	records.resize(numAlive);
+
+	auto remap = [&](std::vector<int>& list)
+	{
+		std::vector<int> newList;
+		newList.reserve(list.size());
+
+		for (auto i : list)
+		{
+			if (newIndexes[i] != -1)
+				newList.push_back(newIndexes[i]);
+		}
+
+		list = std::move(newList);
+	};
+
+	remap(watchedRecords);
+	remap(proxyRecords);
+
+	gridDirty = true;
+
+	// subscribe the new cables in the visible area
+	updateWatchers(visibleArea);
+}
+
+const RectangleGrid& CableComponent::CableHolder::CableLayer::getGrid()
+{
+	if (gridDirty)
+	{
+		grid = {};
+
+		for (int i = 0; i < (int)records.size(); i++)
+			grid.add(records[i].bounds.getUnion(records[i].labelArea), i);
+
+		gridDirty = false;
+	}
+
+	return grid;
+}
+
+void CableComponent::CableHolder::CableLayer::onPositionChange(const ValueTree& v, const Identifier& id)
+{
+	// the positions are updated once after all nodes of a layout change have moved
+	positionsDirty = true;
+	triggerAsyncUpdate();
+}
+
+void CableComponent::CableHolder::CableLayer::onCableOffset(const ValueTree& v, const Identifier& id)
+{
+	for (auto& r : records)
+	{
+		if (r.alive && r.connectionTree == v)
+		{
+			r.offset = (float)v[id];
+			updatePath(r, true);
+		}
+	}
+}
+#endif
+
+CableComponent::CablePopup::SimulatedModulator::SimulatedModulator() :
+	Thread("Simulated modulator")
+{}
+
+CableComponent::CablePopup::SimulatedModulator::~SimulatedModulator()
+{
+	stopThread(500);
+}
+
+void CableComponent::CablePopup::SimulatedModulator::startProducing(ModulationStream& s)
+{
+	if (isThreadRunning())
+		return;
+
+	stream = &s;
+	startThread();
+}
+
+void CableComponent::CablePopup::SimulatedModulator::stopProducing()
+{
+	stopThread(500);
+}
+
+void CableComponent::CablePopup::SimulatedModulator::setTarget(const InvertableParameterRange& range, double value)
+{
+	SpinLock::ScopedLockType sl(targetLock);
+	targetRange = range;
+	targetValue = value;
+}
+
+void CableComponent::CablePopup::SimulatedModulator::run()
+{
+	static constexpr int BlockSize = 64;
+
+	float block[BlockSize];
+
+	auto lastTicks = Time::getHighResolutionTicks();
+	double pending = 0.0;
+
+	const auto delta = MathConstants<double>::twoPi * LfoFrequency / stream->sampleRate;
+	double phase = 0.0;
+	double centre = 0.0;
+	bool firstBlock = true;
+
+	while (!threadShouldExit())
+	{
+		wait(5);
+
+		auto now = Time::getHighResolutionTicks();
+		pending += Time::highResolutionTicksToSeconds(now - lastTicks) * stream->sampleRate;
+		lastTicks = now;
+
+		auto numToWrite = (int)pending;
+		pending -= (double)numToWrite;
+
+		InvertableParameterRange rng;
+		double value;
+
+		{
+			SpinLock::ScopedLockType sl(targetLock);
+			rng = targetRange;
+			value = targetValue;
+		}
+
+		if (firstBlock)
+		{
+			centre = value;
+			firstBlock = false;
+		}
+
+		auto amplitude = rng.getRange().getLength() * Depth;
+
+		while (numToWrite > 0)
+		{
+			auto numThisTime = jmin(numToWrite, BlockSize);
+
+			for (int i = 0; i < numThisTime; i++)
+			{
+				centre += (value - centre) * Smoothing;
+
+				auto v = rng.getRange().clipValue(centre + amplitude * std::sin(phase));
+				block[i] = (float)rng.convertTo0to1(v, false);
+
+				phase = std::fmod(phase + delta, MathConstants<double>::twoPi);
+			}
+
+			stream->push(block, numThisTime);
+			numToWrite -= numThisTime;
+		}
+	}
+}
+
+CableComponent::CablePopup::CablePopup(PooledUIUpdater* updater, CablePinBase* src_, CablePinBase* dst_) :
+	SimpleTimer(updater, false),
+	src(src_),
+	dst(dst_),
+	debugBuffer(new SimpleRingBuffer()),
+	stream(8192)
+{
+	stream.sampleRate = StreamSampleRate;
+	popBuffer.calloc(512);
+
+	debugBuffer->setGlobalUIUpdater(updater);
+	debugBuffer->setRingBufferSize(1, roundToInt(StreamSampleRate * 4.0));
+	debugBuffer->setSamplerate(StreamSampleRate);
+
+	auto c = ParameterHelpers::getParameterColour(dst->data);
+
+	setColour(complex_ui_laf::NodeColourId, c);
+
+	plotter = debugBuffer->getPropertyObject()->createComponent();
+	plotter->setComplexDataUIBase(debugBuffer.get());
+	plotter->setSpecialLookAndFeel(&laf, false);
+	addAndMakeVisible(dynamic_cast<Component*>(plotter.get()));
+	setName("Connection details");
+	setSize(Helpers::ParameterWidth * 2 + 256, 100);
+
+	if (dst->data.getType() == PropertyIds::Parameter)
+	{
+		if (auto ni = NetworkIndex::getFor(dst->data))
+			lastValue = ni->values.subscribe(valueSubscription, dst->data, this, updater);
+	}
+
+	setProducer(new SimulatedModulator());
+}
+
+CableComponent::CablePopup::~CablePopup()
+{
+	// the producer must not write into the stream after it's gone
+	if (producer != nullptr)
+		producer->stopProducing();
+}
+
+void CableComponent::CablePopup::setProducer(ModulationProducer* newProducer)
+{
+	if (producer != nullptr)
+		producer->stopProducing();
+
+	producer = newProducer;
+	onParameterValue(lastValue);
+	updateTimer();
+}
+
+void CableComponent::CablePopup::onParameterValue(double newValue)
+{
+	lastValue = newValue;
+
+	if (dst == nullptr || producer == nullptr)
+		return;
+
+	auto dTree = dst->data;
+	auto pIndex = dTree.getParent().indexOf(dTree);
+
+	if (auto pSource = dynamic_cast<Component*>(dst.get())->findParentComponentOfClass<ParameterSourceObject>())
+		producer->setTarget(pSource->getParameterRange(pIndex), newValue);
+}
+
+void CableComponent::CablePopup::timerCallback()
+{
+	const float* channels[1] = { popBuffer.get() };
+
+	while (auto numRead = stream.pop(popBuffer.get(), 512))
+		debugBuffer->write(channels, 1, numRead);
+}
+
+CableComponent::CableLabel::CableLabel(CableComponent* c) :
+	ComponentMovementWatcher(c),
+	attachedCable(c),
+	currentText(attachedCable->getLabelText())
+{
+	auto w = roundToInt(TextLayoutCache::getStringWidth(GLOBAL_FONT(), currentText)) + 10;
+	setSize(w, 20);
+	updatePosition();
+}
+
+void CableComponent::CableLabel::updatePosition()
+{
+	if (attachedCable.getComponent() != nullptr)
+	{
+		setVisible(shouldShowLabel(attachedCable->getBounds()) && attachedCable->isVisible());
+
+		auto pos = getLabelPosition(attachedCable);
+		setTopRightPosition(pos.getX(), pos.getY());
+	}
+}
+
+juce::Point<int> CableComponent::CableLabel::getLabelPosition(CableComponent* c)
+{
+	if (auto holder = dynamic_cast<Component*>(c->findParentComponentOfClass<CableHolder>()))
+		return holder->getLocalPoint(c, c->e.toInt()).translated(-20, -10);
+
+	return {};
+}
+
+void CableComponent::CableLabel::draw(Graphics& g, LODManager::LODGraphics& lg, Rectangle<float> area, const String& text, Colour c)
+{
+	g.setFont(GLOBAL_FONT());
+	g.setColour(Colour(0xdd222222));
+
+	lg.fillRoundedRectangle(area, area.getHeight() * 0.5f);
+	g.setColour(c);
+
+	if (lg.getCurrentLOD() == 0)
+		TextLayoutCache::drawText(g, text, area.reduced(5.0f, 0.0f), Justification::right);
+	else
+		lg.drawText(text, area.reduced(5.0f, 0.0f), Justification::right);
+}
+
+void CableComponent::CableLabel::componentVisibilityChanged()
+{
+	triggerAsyncUpdate();
+}
+
+void CableComponent::CableLabel::paint(Graphics& g)
+{
+	LODManager::LODGraphics lg(g, *this);
+
+	if (attachedCable.getComponent() != nullptr)
+		draw(g, lg, getLocalBounds().toFloat(), currentText, attachedCable->colour2);
+}
+
+CableComponent::CableHolder::Blinker::Blinker(CableHolder& p) :
+	parent(p)
+{
+
+}
+
+void CableComponent::CableHolder::Blinker::blink(WeakReference<CablePinBase> target)
+{
+	if (target == nullptr)
+		return;
+
+	for (auto& s : blinkTargets)
+	{
+		if (s.first == target)
+		{
+			s.second = 10;
+			startTimer(15);
+			return;
+		}
+	}
+
+	blinkTargets.add({ target, 10 });
+	startTimer(15);
+}
+
+void CableComponent::CableHolder::Blinker::unblink(CablePinBase::WeakPtr target)
+{
+	if (target == nullptr)
+		return;
+
+	for (int i = 0; i < blinkTargets.size(); i++)
+	{
+		if (blinkTargets[i].first == target)
+			blinkTargets.remove(i--);
+	}
+
+	target->setBlinkAlpha(0.0f);
+}
+
+void CableComponent::CableHolder::Blinker::timerCallback()
+{
+	for (auto& s : blinkTargets)
 	{
 		if (s.first != nullptr)
 		{
@@ -818,7 +1698,7 @@ juce::ValueTree CableComponent::getConnectionTree(CablePinBase* src, CablePinBas
 CableComponent::CableComponent(Lasso& l, CablePinBase* src_, CablePinBase* dst_) :
 	CableBase(&l),
 	SelectableComponent(&l),
-	SimpleTimer(l.getUpdater()),
+	SimpleTimer(l.getUpdater(), false),
 	src(src_),
 	dst(dst_),
 	connectionTree(getConnectionTree(src_, dst_))
@@ -839,8 +1719,19 @@ CableComponent::CableComponent(Lasso& l, CablePinBase* src_, CablePinBase* dst_)
 	removeListener.setCallback(connectionTree, Helpers::UIMode, true, [this](const ValueTree& v)
 		{
 			auto ch = findParentComponentOfClass<CableHolder>();
-			ch->rebuildCables();
+			ch->onConnectionChange(v, false);
 		});
+
+	subscribeToTargetValue();
+}
+
+void CableComponent::subscribeToTargetValue()
+{
+	if (dst != nullptr && dst->data.getType() == PropertyIds::Parameter)
+	{
+		if (auto ni = NetworkIndex::getFor(dst->data))
+			lastValue.setModValueIfChanged(ni->values.subscribe(valueSubscription, dst->data, this, lasso->getUpdater()));
+	}
 }
 
 void CableComponent::onCableOffset(const Identifier&, const var& newValue)
@@ -866,9 +1757,13 @@ void CableComponent::updatePosition(const Identifier& id, const var&)
 
 	auto ns = Point<float>(start.getRight() - 3.0f, start.getCentreY());
 	auto end = parent->getLocalArea(dst, dst->getLocalBounds()).toFloat();
-	auto ne = Point<float>(end.getX(), end.getCentreY());
+	auto ne = Point<float>(end.getX(), end.getCentreY()).translated(-1.0f * (float)Helpers::ParameterMargin, 0.0f);
+
+	// skip the path calculation if the pins haven't moved
+	if (!getBounds().isEmpty() && parent->getLocalPoint(this, s) == ns && parent->getLocalPoint(this, e) == ne)
+		return;
 
-	rebuildPath(ns, ne.translated(-1.0f * (float)Helpers::ParameterMargin, 0.0f), parent);
+	rebuildPath(ns, ne, parent);
 }
 
 juce::ValueTree CableComponent::getValueTree() const
@@ -33,6 +33,14 @@
 #pragma once
 
 
+/** Set this to 1 in order to replace the CableComponents of a CableHolder with a single layer component.
+	The layer stores the cables as plain records and paints them (along with their labels) in one pass.
+	A CableComponent is only created as selectable proxy for the cables that are found by the lasso.
+*/
+#ifndef SCRIPTNODE_BATCHED_CABLES
+#define SCRIPTNODE_BATCHED_CABLES 0
+#endif
+
 namespace scriptnode {
 using namespace hise;
 using namespace juce;
@@ -50,9 +58,29 @@ struct CableBase : public Component,
 	void rebuildPath(Point<float> newStart, Point<float> newEnd, Component* parent);
 	void paint(Graphics& g) override;
 
+	/** Creates the curve and the arrow between the two points. */
+	static void createCablePath(Path& p, Path& arrow, Point<float> start, Point<float> end, float offset);
+
+	/** Draws the cable. This is used by paint() and by the cable layer of the CableHolder. */
+	static void drawCable(Graphics& g, const Path& p, const Path& arrow, Point<float> start, Point<float> end, Colour c1, Colour c2, int lod, bool over);
+
 	Path p;
 	Path arrow;
 	bool over = false;
+
+private:
+
+	static constexpr float HitTestDistance = 5.0f;
+
+	/** Flattens the path into line segments so that hitTest() doesn't have to do this for every mouse event. */
+	void updateHitTestSegments();
+
+	Rectangle<float> hitTestBounds;
+	std::vector<Line<float>> segments;
+	std::vector<Rectangle<float>> segmentBounds;
+
+public:
+
 	Point<float> s, e;
 
 	float offset = 0.0f;
@@ -78,11 +106,49 @@ struct DraggedCable : public CableBase
 	CablePinBase::WeakPtr src;
 	CablePinBase::WeakPtr hoveredPin;
 	Component::SafePointer<ContainerComponent::AddButton> hoveredAddButton;
+
+private:
+
+	/** The bounds of all possible drop targets in the root component that are collected when the
+		cable is dragged the first time (the layout doesn't change until the cable is released).
+	*/
+	struct DropTargetIndex
+	{
+		DropTargetIndex(Component* root, CablePinBase* src);
+
+		/** Returns the first pin that contains the root position and sets its area. */
+		CablePinBase* getPin(Point<int> rootPosition, Rectangle<int>& pinArea) const;
+
+		ContainerComponent::AddButton* getAddButton(Point<int> rootPosition) const;
+
+	private:
+
+		struct Pin
+		{
+			CablePinBase::WeakPtr pin;
+			Rectangle<int> area;
+		};
+
+		struct Button
+		{
+			Component::SafePointer<ContainerComponent::AddButton> button;
+			Rectangle<int> area;
+		};
+
+		std::vector<Pin> pins;
+		std::vector<Button> buttons;
+		RectangleGrid pinGrid;
+		RectangleGrid buttonGrid;
+	};
+
+	ScopedPointer<DropTargetIndex> dropTargets;
 };
 
 struct CableComponent : public CableBase,
 						public SelectableComponent,
-						public PooledUIUpdater::SimpleTimer
+						public PooledUIUpdater::SimpleTimer,
+						public NetworkIndex::ValueHub::Listener,
+						public VisibilityClient
 {
 	struct CableLabel : public Component,
 						public ComponentMovementWatcher,
@@ -105,54 +171,92 @@ struct CableComponent : public CableBase,
 		void componentPeerChanged() override {};
 		void paint(Graphics& g) override;
 
+		/** Returns the top right position of the label in the holder component. */
+		static Point<int> getLabelPosition(CableComponent* c);
+
+		/** Checks whether the cable is big enough to show a label. */
+		static bool shouldShowLabel(Rectangle<int> cableBounds) { return cableBounds.getWidth() > 300 || cableBounds.getHeight() > 500; }
+
+		static void draw(Graphics& g, LODManager::LODGraphics& lg, Rectangle<float> area, const String& text, Colour c);
+
 		Component::SafePointer<CableComponent> attachedCable;
 		String currentText;
 	};
 
 	struct CablePopup: public Component,
-					   public PooledUIUpdater::SimpleTimer
+					   public PooledUIUpdater::SimpleTimer,
+					   public NetworkIndex::ValueHub::Listener
 	{
-		CablePopup(PooledUIUpdater* updater, CablePinBase* src_, CablePinBase* dst_):
-		  SimpleTimer(updater),
-		  src(src_),
-		  dst(dst_),
-		  debugBuffer(new SimpleRingBuffer())
+		static constexpr double StreamSampleRate = 44100.0 / 32.0;
+
+		/** A stand-in for the audio thread that sweeps a sine LFO around the current value of the target
+			parameter. The values are calculated per sample in the parameter range so the plotter shows the
+			curve that the skew of the range creates.
+		*/
+		struct SimulatedModulator : public Thread,
+									public ModulationProducer
 		{
-			debugBuffer->setGlobalUIUpdater(updater);
-			debugBuffer->setRingBufferSize(1, 44100);
-			debugBuffer->setSamplerate(44100.0 * 0.25);
+			SimulatedModulator();
+			~SimulatedModulator() override;
 
-			auto c = ParameterHelpers::getParameterColour(dst->data);
+			void startProducing(ModulationStream& s) override;
+			void stopProducing() override;
+			void setTarget(const InvertableParameterRange& range, double value) override;
 
-			setColour(complex_ui_laf::NodeColourId, c);
+			void run() override;
 
-			plotter = debugBuffer->getPropertyObject()->createComponent();
-			plotter->setComplexDataUIBase(debugBuffer.get());
-			plotter->setSpecialLookAndFeel(&laf, false);
-			addAndMakeVisible(dynamic_cast<Component*>(plotter.get()));
-			setName("Connection details");
-			setSize(Helpers::ParameterWidth * 2 + 256, 100);
-			start();
-		}
+		private:
 
-		void timerCallback() override
-		{
-			auto dTree = dst->data;
-			auto pIndex = dTree.getParent().indexOf(dTree);
-			auto pSource = dynamic_cast<Component*>(dst.get())->findParentComponentOfClass<ParameterSourceObject>();
-			auto rng = pSource->getParameterRange(pIndex);
-			auto value = rng.convertTo0to1(pSource->getParameterValue(pIndex), false);
-			auto now = Time::getMillisecondCounter();
-			auto delta = jmin<int>(30, now - lastTime);
+			static constexpr double LfoFrequency = 0.5;
+
+			/** The amplitude of the LFO relative to the length of the parameter range. */
+			static constexpr double Depth = 0.25;
+
+			/** The coefficient of the one pole filter that smoothes the value changes from the UI. */
+			static constexpr double Smoothing = 0.02;
+
+			SpinLock targetLock;
+			InvertableParameterRange targetRange;
+			double targetValue = 0.0;
+
+			ModulationStream* stream = nullptr;
+		};
+
+		CablePopup(PooledUIUpdater* updater, CablePinBase* src_, CablePinBase* dst_);
+		~CablePopup() override;
+
+		/** Replaces the source of the plotted values (the SimulatedModulator by default). */
+		void setProducer(ModulationProducer* newProducer);
 
-			lastTime = now;
+		void visibilityChanged() override { updateTimer(); }
+		void parentHierarchyChanged() override { updateTimer(); }
 
-			auto numSamples = roundToInt(44100.0 * 0.25 * (double)delta * 0.001);
+		/** Only runs the timer and the producer while the popup is on screen. */
+		void updateTimer()
+		{
+			if (isShowing())
+			{
+				start();
 
-			debugBuffer->write(value, numSamples);
+				if (producer != nullptr)
+					producer->startProducing(stream);
+			}
+			else
+			{
+				stop();
+
+				if (producer != nullptr)
+					producer->stopProducing();
+			}
 		}
 
-		uint32 lastTime = 0;
+		void onParameterValue(double newValue) override;
+
+		/** Moves the values of the stream into the ring buffer of the plotter. */
+		void timerCallback() override;
+
+		/** The queue that the producer writes to. */
+		ModulationStream& getStream() { return stream; }
 
 		void resized() override
 		{
@@ -212,25 +316,37 @@ struct CableComponent : public CableBase,
 		ScopedPointer<RingBufferComponentBase> plotter;
 
 		complex_ui_laf laf;
+
+		ModulationStream stream;
+		ScopedPointer<ModulationProducer> producer;
+		NetworkIndex::ValueHub::Subscription valueSubscription;
+		double lastValue = 0.0;
+		HeapBlock<float> popBuffer;
 	};
 
 	struct CableHolder
 	{
+		/** The cables and stubs that should exist for a set of sources. */
+		struct ConnectionSet;
+
 		CableHolder(const ValueTree& v);
 
 		virtual ~CableHolder() = default;
 
+		/** Synchronises the cables and stubs with all connections of the network. */
 		void rebuildCables();
 
+		/** Called after cables have been added or removed. */
+		virtual void cablesRebuilt() {}
+
 		void onHideCable(const ValueTree& v, const Identifier& id)
 		{
 			rebuildCables();
 		}
 
-		void onConnectionChange(const ValueTree& v, bool wasAdded)
-		{
-			rebuildCables();
-		}
+		/** Only updates the cables of the source of the given connection. Hidden connections and
+			connections to locked containers change the outside parameters and do a full rebuild. */
+		void onConnectionChange(const ValueTree& v, bool wasAdded);
 
 		struct Stub;
 
@@ -246,6 +362,119 @@ struct CableComponent : public CableBase,
 			CableHolder& parent;
 		} blinker;
 
+#if SCRIPTNODE_BATCHED_CABLES
+		/** A component behind all other children of the holder that stores the cables in a contiguous
+			array and paints the ones that intersect the clip region in one pass.
+
+			The lasso asks the layer for the cables in its area and the layer creates a CableComponent
+			as selectable proxy for these cables (so the actions that work with the selection don't need
+			to know about the layer). A proxy paints itself and is deleted when it gets deselected.
+		*/
+		struct CableLayer : public Component,
+							public PooledUIUpdater::SimpleTimer,
+							public ChangeListener,
+							public AsyncUpdater
+		{
+			CableLayer(CableHolder& h, const ValueTree& networkTree);
+			~CableLayer() override;
+
+			/** Removes the cables of the affected sources that are not in the set and creates the missing ones. */
+			void applyConnections(ConnectionSet& set, const std::function<bool(CablePinBase*)>& isAffected);
+
+			/** Checks whether the connection has a cable from or to an outside parameter. */
+			bool isOutsideConnection(const ValueTree& connection) const;
+
+			/** Removes the cables of the connection and returns true if there was one. */
+			bool removeConnection(const ValueTree& connection);
+
+			/** Adds the proxies of the cables that intersect the lasso area (in holder coordinates). */
+			void findLassoItems(Array<SelectableComponent::WeakPtr>& itemsFound, Rectangle<int> area);
+
+			/** Adds the proxies of the cables with the given connection trees to the selection. */
+			void selectConnections(const Array<ValueTree>& connections);
+
+			/** Subscribes the cables in the visible area to the value of their target and releases all others. */
+			void updateWatchers(Rectangle<int> newVisibleArea);
+
+			void paint(Graphics& g) override;
+
+			/** Fades out the change highlight of the watched cables. */
+			void timerCallback() override;
+
+			void changeListenerCallback(ChangeBroadcaster*) override { triggerAsyncUpdate(); }
+
+			/** Updates the cable positions after a layout change and deletes the deselected proxies. */
+			void handleAsyncUpdate() override;
+
+		private:
+
+			struct ValueWatcher : public NetworkIndex::ValueHub::Listener
+			{
+				ValueWatcher(CableLayer& parent_) :
+				  parent(parent_)
+				{}
+
+				void onParameterValue(double newValue) override;
+
+				CableLayer& parent;
+				ModValue lastValue;
+				int changeAlpha = 0;
+				NetworkIndex::ValueHub::Subscription subscription;
+			};
+
+			struct Record
+			{
+				CablePinBase::WeakPtr src, dst;
+				ValueTree connectionTree;
+				Path p, arrow;
+				Point<float> s, e;
+				float offset = 0.0f;
+				Colour colour1, colour2;
+				String label;
+				Rectangle<int> bounds;
+				Rectangle<int> labelArea;
+				bool alive = true;
+				std::unique_ptr<ValueWatcher> watcher;
+				Component::SafePointer<CableComponent> proxy;
+			};
+
+			void addRecord(CablePinBase* src, CablePinBase* dst);
+			void removeRecord(Record& r);
+
+			/** Calculates the path from the pin positions (if they have changed or force is true). */
+			void updatePath(Record& r, bool force);
+
+			CableComponent* getProxy(int index);
+
+			/** Removes the dead records and updates the indexes of the watchers and proxies. */
+			void compact();
+
+			const RectangleGrid& getGrid();
+
+			void onPositionChange(const ValueTree& v, const Identifier& id);
+			void onCableOffset(const ValueTree& v, const Identifier& id);
+
+			CableHolder& holder;
+			WeakReference<SelectableComponent::Lasso> lasso;
+
+			std::vector<Record> records;
+			std::vector<int> watchedRecords;
+			std::vector<int> proxyRecords;
+
+			RectangleGrid grid;
+			bool gridDirty = true;
+			bool positionsDirty = false;
+
+			Rectangle<int> visibleArea;
+
+			valuetree::RecursivePropertyListener positionListener;
+			valuetree::RecursivePropertyListener offsetListener;
+		};
+
+		ScopedPointer<CableLayer> cableLayer;
+#endif
+
+		/** The cable components (or only the selectable proxies if the cables are stored in the layer). */
 		OwnedArray<CableComponent> cables;
 		OwnedArray<CableLabel> labels;
 		OwnedArray<Component> stubs;
@@ -254,6 +483,29 @@ struct CableComponent : public CableBase,
 		bool initialised = false;
 		valuetree::RecursivePropertyListener hideConnectionListener;
 		valuetree::RecursiveTypedChildListener connectionListener;
+
+	private:
+
+		void addConnectionsForSource(ConnectionSet& set, CablePinBase* src, bool forceCable);
+
+		/** Removes the cables and stubs of the affected sources that are not in the set and creates the missing ones. */
+		void applyConnections(ConnectionSet& set, const std::function<bool(CablePinBase*)>& isAffected);
+
+		/** Creates a cable component and adds it behind all other children. */
+		CableComponent* createCable(CablePinBase* src, CablePinBase* dst);
+
+		/** Removes the target from the set if the existing cable is still required. */
+		static bool takeConnection(ConnectionSet& set, CablePinBase* src, CablePinBase* dst, const ValueTree& connectionTree);
+
+		static std::pair<Colour, Colour> getCableColours(CablePinBase* src, CablePinBase* dst);
+
+#if SCRIPTNODE_BATCHED_CABLES
+		ValueTree networkTree;
+#endif
+
+		CablePinBase* findCableSource(const ValueTree& connection);
+		static bool isOutsideParameter(CablePinBase* p);
+		static bool isLockedTarget(const ValueTree& connection);
 	};
 
 	static ValueTree getConnectionTree(CablePinBase* src, CablePinBase* dst);
@@ -270,36 +522,42 @@ struct CableComponent : public CableBase,
 	InvertableParameterRange getParameterRange(int index) const override { jassertfalse; return {}; }
 	double getParameterValue(int index) const override { jassertfalse; return {}; }
 
-	void timerCallback() override
+	void onParameterValue(double newValue) override
 	{
-		auto lastAlpha = changeAlpha;
-
-		if (dst != nullptr)
+		if(lastValue.setModValueIfChanged(newValue))
 		{
-			if (auto p = dst->findParentComponentOfClass<ParameterSourceObject>())
-			{
-				auto pIndex = dst->data.getParent().indexOf(dst->data);
-
-				if(lastValue.setModValueIfChanged(p->getParameterValue(pIndex)))
-				{
-					if(changeAlpha == -1)
-						changeAlpha = 0;
-					else
-						changeAlpha = 11;
-				}
-			}
+			// the timer only runs while the change highlight fades out
+			changeAlpha = 11;
+			start();
 		}
+	}
 
+	void timerCallback() override
+	{
 		if(changeAlpha > 0)
 		{
 			changeAlpha--;
+			repaint();
+		}
 
-			if(changeAlpha != lastAlpha)
-				repaint();
-			else
-			{
-				int x = 5;
-			}
+		if(changeAlpha <= 0)
+			stop();
+	}
+
+	void subscribeToTargetValue();
+
+	void activeStateChanged() override
+	{
+		if (isActive())
+		{
+			// this catches up with the current value without highlighting the change
+			subscribeToTargetValue();
+		}
+		else
+		{
+			valueSubscription.reset();
+			changeAlpha = 0;
+			stop();
 		}
 	}
 
@@ -314,7 +572,9 @@ struct CableComponent : public CableBase,
 	float downOffset = 0.0f;
 
 	ModValue lastValue;
-	int changeAlpha = -1;
+	int changeAlpha = 0;
+
+	NetworkIndex::ValueHub::Subscription valueSubscription;
 
 	ValueTree connectionTree;
 	Point<float> hoverPoint;
@@ -49,6 +49,67 @@ void DummyComplexDataProvider::Editor::checkBounds(Rectangle<int>& bounds, const
 	findParentComponentOfClass<NodeComponent>()->setFixSize(bounds.expanded(10));
 }
 
+Image* display_buffer_library::oscillator::getCachedShape(Rectangle<int> imageBounds)
+{
+	for (auto& s : shapeCache)
+	{
+		if (s.mode == (int)oscProvider.currentMode &&
+			s.phaseStep == getPhaseStep(imageBounds) &&
+			s.imageBounds == imageBounds)
+		{
+			return &s.img;
+		}
+	}
+
+	return nullptr;
+}
+
+void display_buffer_library::oscillator::updateDisplay()
+{
+	if (getWidth() == 0 || getHeight() == 0)
+		return;
+
+	auto scale = Component::getApproximateScaleFactorForComponent(this);
+	auto imageBounds = getLocalBounds().transformedBy(AffineTransform::scale(scale));
+
+	if (auto img = getCachedShape(imageBounds))
+	{
+		currentShape = *img;
+		dp->setVisible(false);
+		repaint();
+		return;
+	}
+
+	bd.rb->getUpdater().sendDisplayChangeMessage(bd.rb->getReadBuffer().getNumSamples(), sendNotificationSync);
+
+	currentShape = {};
+	dp->setVisible(true);
+
+	// only take a snapshot of the shapes that are requested again (eg. when the phase is dragged back and forth)
+	auto phaseStep = getPhaseStep(imageBounds);
+	auto key = std::make_pair((int)oscProvider.currentMode, phaseStep);
+	auto it = std::find(missedShapes.begin(), missedShapes.end(), key);
+
+	if (it == missedShapes.end())
+	{
+		missedShapes.push_back(key);
+		return;
+	}
+
+	missedShapes.erase(it);
+
+	if ((int)shapeCache.size() >= MaxNumCachedShapes)
+		shapeCache.erase(shapeCache.begin());
+
+	shapeCache.push_back({ (int)oscProvider.currentMode, phaseStep, imageBounds, dp->createComponentSnapshot(dp->getLocalBounds(), true, scale) });
+}
+
+void display_buffer_library::oscillator::paint(Graphics& g)
+{
+	if (currentShape.isValid() && !dp->isVisible())
+		g.drawImage(currentShape, getLocalBounds().toFloat());
+}
+
 void NodeResizer::paint(Graphics& g)
 {
 	Path p;
@@ -64,7 +64,8 @@ namespace display_buffer_library
 	};
 
 	struct WrappedDisplayBufferComponent : public Component,
-										   public PooledUIUpdater::SimpleTimer
+										   public PooledUIUpdater::SimpleTimer,
+										   public VisibilityClient
 	{
 		WrappedDisplayBufferComponent(const BuildData& bd_) :
 			SimpleTimer(bd_.updater, false),
@@ -75,11 +76,35 @@ namespace display_buffer_library
 
 	protected:
 
-		struct WatchedParameter
+		/** Subscribes to the value of a node parameter through the network's value hub.
+
+			The changes are collected until the next timer callback of the display component, so
+			a display that watches multiple parameters is only updated once per frame.
+		*/
+		struct WatchedParameter : public NetworkIndex::ValueHub::Listener
 		{
+			WatchedParameter(WrappedDisplayBufferComponent& parent_, const ValueTree& data_, int index_) :
+			  parent(parent_),
+			  data(data_),
+			  name(data_[PropertyIds::ID].toString()),
+			  index(index_)
+			{}
+
+			void onParameterValue(double newValue) override
+			{
+				lastValue = newValue;
+				dirty = true;
+				parent.start();
+			}
+
+			WrappedDisplayBufferComponent& parent;
+			ValueTree data;
 			String name;
 			int index;
-			double lastValue;
+			double lastValue = 0.0;
+			bool dirty = true;
+
+			NetworkIndex::ValueHub::Subscription subscription;
 		};
 
 		void addWatchedParameterIds(const StringArray& parameters)
@@ -92,48 +117,81 @@ namespace display_buffer_library
 
 			for (auto p : ptree)
 			{
-				auto pid = p[PropertyIds::ID].toString();
-				if (parameters.contains(pid))
+				if (parameters.contains(p[PropertyIds::ID].toString()))
+					watchedParameters.add(new WatchedParameter(*this, p, idx));
+
+				idx++;
+			}
+
+			activeStateChanged();
+		}
+
+		void activeStateChanged() override
+		{
+			auto ni = NetworkIndex::getFor(bd.v);
+
+			if (isActive() && ni != nullptr && !watchedParameters.isEmpty())
+			{
+				for (auto wp : watchedParameters)
 				{
-					watchedParameters.push_back({ pid, idx, 0.0 });
+					auto v = ni->values.subscribe(wp->subscription, wp->data, wp, bd.updater);
 
+					// catch up with the changes while the display was inactive
+					if (v != wp->lastValue)
+					{
+						wp->lastValue = v;
+						wp->dirty = true;
+					}
 				}
 
-
-				idx++;
+				timerCallback();
 			}
-
-			if (!watchedParameters.empty())
-				start();
 			else
+			{
+				for (auto wp : watchedParameters)
+					wp->subscription.reset();
+
 				stop();
+			}
 		}
 
 
 		complex_ui_laf laf;
 		BuildData bd;
 
+		/** Called for every parameter that has changed since the last frame. */
 		virtual void onParameterChange(const WatchedParameter& p)
 		{
 		}
 
+		/** Called once after the onParameterChange() calls of a frame. */
+		virtual void updateDisplay()
+		{
+		}
+
 	private:
 
 		void timerCallback() override
 		{
-			for (auto& wp : watchedParameters)
-			{
-				auto lv = wp.lastValue;
-				auto nv = bd.pSource->getParameterValue(wp.index);
+			stop();
 
-				wp.lastValue = nv;
+			bool anyChanged = false;
 
-				if (lv != nv)
-					onParameterChange(wp);
+			for (auto wp : watchedParameters)
+			{
+				if (wp->dirty)
+				{
+					wp->dirty = false;
+					onParameterChange(*wp);
+					anyChanged = true;
+				}
 			}
+
+			if (anyChanged)
+				updateDisplay();
 		}
 
-		std::vector<WatchedParameter> watchedParameters;
+		OwnedArray<WatchedParameter> watchedParameters;
 
 		JUCE_DECLARE_WEAK_REFERENCEABLE(WrappedDisplayBufferComponent);
 	};
@@ -157,8 +215,6 @@ namespace display_buffer_library
 
 			bd.rb->getUpdater().sendDisplayChangeMessage(bd.rb->getReadBuffer().getNumSamples(), sendNotificationSync);
 
-			addAndMakeVisible(dp);
-
 			addWatchedParameterIds({ "Mode", "Phase" });
 
 			setSize(Helpers::ParameterWidth, 80);
@@ -170,14 +226,22 @@ namespace display_buffer_library
 				oscProvider.currentMode = (OscillatorDisplayProvider::Mode)(int)p.lastValue;
 
 			if (p.name == "Phase")
-				oscProvider.uiData.uptime = p.lastValue * 2048.0;
-
-			bd.rb->getUpdater().sendDisplayChangeMessage(bd.rb->getReadBuffer().getNumSamples(), sendNotificationSync);
+			{
+				phase = p.lastValue;
+				oscProvider.uiData.uptime = phase * 2048.0;
+			}
 		}
 
+		void updateDisplay() override;
+
+		void paint(Graphics& g) override;
+
 		void resized() override
 		{
 			dp->setBounds(getLocalBounds());
+			shapeCache.clear();
+			missedShapes.clear();
+			updateDisplay();
 		}
 
 		ScopedPointer<OscillatorDisplayProvider::osc_display> dp;
@@ -187,6 +251,38 @@ namespace display_buffer_library
 		{
 			return new oscillator(bd);
 		}
+
+	private:
+
+		static constexpr int MaxNumCachedShapes = 32;
+
+		/** The rendered display for a combination of mode, phase step and size.
+
+			The cache only stores a snapshot when a shape is requested for the second time (eg. when
+			the phase is dragged back and forth or the mode is toggled). A single sweep over the phase
+			renders every step live and leaves the cache empty.
+		*/
+		struct CachedShape
+		{
+			int mode;
+			int phaseStep;
+			Rectangle<int> imageBounds;
+			Image img;
+		};
+
+		Image* getCachedShape(Rectangle<int> imageBounds);
+
+		/** The phase in steps of one pixel of the display. Phases within the same step can't be told apart. */
+		int getPhaseStep(Rectangle<int> imageBounds) const { return roundToInt(phase * (double)imageBounds.getWidth()); }
+
+		double phase = 0.0;
+
+		std::vector<CachedShape> shapeCache;
+
+		/** The mode and phase step of the shapes that were rendered once without a snapshot. */
+		std::vector<std::pair<int, int>> missedShapes;
+
+		Image currentShape;
 	};
 
 	struct Factory
@@ -42,6 +42,14 @@ ContainerComponent::CableSetup::CableSetup(ContainerComponent& parent_, const Va
 
 	if (type == ContainerType::Branch)
 		branchListener.setCallback(v.getChildWithName(PropertyIds::Parameters).getChild(0), { PropertyIds::Value }, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onBranch));
+
+	cableOffsetListener.setCallback(v.getChildWithName(PropertyIds::Nodes), { UIPropertyIds::CableOffset }, Helpers::UIMode, VT_BIND_RECURSIVE_PROPERTY_LISTENER(onCableOffset));
+}
+
+void ContainerComponent::CableSetup::onCableOffset(const ValueTree& v, const Identifier& id)
+{
+	geometry.dirty = true;
+	parent.repaint();
 }
 
 bool ContainerComponent::CableSetup::isSerialType() const
@@ -70,7 +78,8 @@ void ContainerComponent::CableSetup::onBranch(const Identifier&, const var& newV
 
 void ContainerComponent::CableSetup::updatePins(ContainerComponent& p)
 {
-	
+	geometry.dirty = true;
+
 	pinPositions.containerStart = { 0.0f, (float)Helpers::HeaderHeight };
 	pinPositions.containerEnd = pinPositions.containerStart.translated((float)p.getWidth(), 0.0f);
 	pinPositions.containerStart = pinPositions.containerStart.translated(Helpers::ParameterMargin + Helpers::ContainerParameterWidth - 25.0f, 0.0f);
@@ -225,9 +234,10 @@ void ContainerComponent::CableSetup::init(const ValueTree& v)
 
 	jassert(Helpers::isContainerNode(v));
 
-	auto n = Helpers::getFactoryPath(v).second;
+	using CT = NodeDescriptor::ContainerType;
+	auto n = NodeDescriptor::get(v).containerType;
 
-	if (n == "split")
+	if (n == CT::Split)
 	{
 		type = ContainerType::Split;
 
@@ -239,7 +249,7 @@ void ContainerComponent::CableSetup::init(const ValueTree& v)
 		for (int i = 0; i < numNodes; i++)
 			connections.push_back(mc);
 	}
-	else if (n == "multi")
+	else if (n == CT::Multi)
 	{
 		type = ContainerType::Multi;
 
@@ -255,11 +265,11 @@ void ContainerComponent::CableSetup::init(const ValueTree& v)
 			connections.push_back(mc);
 		}
 	}
-	else if (n == "branch")
+	else if (n == CT::Branch)
 	{
 		type = ContainerType::Branch;
 	}
-	else if (n == "modchain")
+	else if (n == CT::ModChain)
 	{
 		type = ContainerType::ModChain;
 		numChannels = 1;
@@ -270,7 +280,7 @@ void ContainerComponent::CableSetup::init(const ValueTree& v)
 
 		connections.push_back(mc);
 	}
-	else if (n == "offline")
+	else if (n == CT::Offline)
 	{
 		type = ContainerType::Offline;
 		numChannels = 0;
@@ -334,17 +344,50 @@ float ContainerComponent::CableSetup::getCableOffset(int nodeIndex, float maxWid
 
 void ContainerComponent::CableSetup::draw(Graphics& g)
 {
+	auto currentLod = LODManager::getLOD(parent);
+
+	if (geometry.dirty || geometry.lod != currentLod)
+		rebuildGeometry(currentLod);
+
 	auto colour = Helpers::getNodeColour(parent.getValueTree());
 
+	for (const auto& item : geometry.items)
+	{
+		if (!item.pin.isEmpty())
+		{
+			g.setColour(Colours::grey);
+			g.fillPath(item.pin);
+		}
+
+		if (!item.shadow.isEmpty())
+		{
+			g.setColour(Colours::black.withAlpha(0.7f));
+			g.fillPath(item.shadowDots);
+			g.fillPath(item.shadow);
+		}
+
+		if (!item.cable.isEmpty())
+		{
+			g.setColour(item.active ? colour : colour.withAlpha(0.2f));
+			g.fillPath(item.cable);
+		}
+	}
+}
+
+void ContainerComponent::CableSetup::rebuildGeometry(int newLod)
+{
+	geometry.clear();
+	geometry.lod = newLod;
+	geometry.dirty = false;
+
 	if (!isSerialType() && pinPositions.childPositions.size() != connections.size())
 		return;
 
 	const auto delta = (float)(Helpers::SignalHeight) / (float)numChannels;
 
 	CableDrawData cd;
-	cd.lod = LODManager::getLOD(parent);
+	cd.lod = newLod;
 	cd.numChannels = numChannels;
-	cd.c = colour;
 
 	pinPositions.containerStart.setX(cd.lod == 0 ? Helpers::ParameterMargin + Helpers::ContainerParameterWidth - 25.0f : 0);
 
@@ -361,14 +404,15 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 
 		if (cd.lod == 0)
 		{
-			g.setColour(Colours::grey);
 			PathFactory::scalePath(pin, s);
-			g.fillPath(pin);
+			geometry.items.push_back({});
+			geometry.items.back().pin = pin;
 
 			if (type != ContainerType::ModChain)
 			{
 				PathFactory::scalePath(pin, e);
-				g.fillPath(pin);
+				geometry.items.push_back({});
+				geometry.items.back().pin = pin;
 			}
 		}
 
@@ -377,15 +421,13 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 		if (!routeThroughChildNodes())
 		{
 			cd.setCoordinates(s.getCentre(), e.getCentre(), 0.0f, c);
-			cd.draw(g, true);
+			cd.addToGeometry(geometry, true);
 		}
 	}
 
 	if (!routeThroughChildNodes())
 		return;
 
-	g.setColour(colour);
-
 	if (isSerialType())
 	{
 		if (pinPositions.childPositions.size() > 0)
@@ -402,7 +444,7 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 				auto o = getCableOffset(0, p1, p2);
 
 				cd.setCoordinates(p1.translated(0, offset), p2.translated(0, offset), o, c);
-				cd.draw(g, false);
+				cd.addToGeometry(geometry, false);
 				offset += delta;
 			}
 		}
@@ -421,7 +463,7 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 					auto o = getCableOffset(i + 1, p1, p2);
 
 					cd.setCoordinates(p1.translated(offset, 0), p2.translated(offset, 0), o, c);
-					cd.draw(g, true);
+					cd.addToGeometry(geometry, true);
 					offset += delta;
 				}
 			}
@@ -433,7 +475,7 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 				{
 					auto o = getCableOffset(i + 1, p1, p2);
 					cd.setCoordinates(p1.translated(0, offset), p2.translated(0, offset), o, c);
-					cd.draw(g, false);
+					cd.addToGeometry(geometry, false);
 					offset += delta;
 				}
 			}
@@ -452,7 +494,7 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 
 				auto o = getCableOffset(pinPositions.childPositions.size(), p1, p2);
 				cd.setCoordinates(p1.translated(0, offset), p2.translated(-xOffset, offset), o, c);
-				cd.draw(g, false);
+				cd.addToGeometry(geometry, false);
 				offset += delta;
 			}
 		}
@@ -484,12 +526,12 @@ void ContainerComponent::CableSetup::draw(Graphics& g)
 				cd.p1 = p1;
 				cd.p2 = p2;
 
-				cd.draw(g, false);
+				cd.addToGeometry(geometry, false);
 
 				cd.p1 = p3;
 				cd.p2 = p4;
 
-				cd.draw(g, false);
+				cd.addToGeometry(geometry, false);
 				cIndex++;
 			}
 		}
@@ -720,6 +762,10 @@ void ContainerComponent::onChildPositionUpdate(const ValueTree& v, const Identif
 							{
 								c.cables.updatePins(c);
 							});
+
+						// a layout change might move components into the visible area
+						if (auto dn = findParentComponentOfClass<DspNetworkComponent>())
+							dn->triggerVisibilityUpdate();
 					}
 
 					break;
@@ -729,8 +775,30 @@ void ContainerComponent::onChildPositionUpdate(const ValueTree& v, const Identif
 	}
 }
 
+ContainerComponent::GroupMemberWatcher::GroupMemberWatcher(ContainerComponent& parent, const ValueTree& v) :
+	data(v)
+{
+	auto memberIds = UIPropertyIds::Helpers::getPositionIds();
+	memberIds.addArray({ PropertyIds::ID, PropertyIds::Name, PropertyIds::NodeColour, PropertyIds::Folded, PropertyIds::Locked,
+						 PropertyIds::Comment, UIPropertyIds::CommentWidth, UIPropertyIds::CommentOffsetX });
+
+	listener.setCallback(v, memberIds, Helpers::UIMode, [&parent](const Identifier&, const var&)
+	{
+		parent.onGroupMemberChange();
+	});
+}
+
+void ContainerComponent::onGroupMemberChange()
+{
+	for (auto g : groups)
+		g->markDirty();
+}
+
 void ContainerComponent::onChildAddRemove(const ValueTree& v, bool wasAdded)
 {
+	for (auto g : groups)
+		g->markDirty();
+
 	if (wasAdded)
 	{
 		NodeComponent* nc;
@@ -769,6 +837,7 @@ void ContainerComponent::onChildAddRemove(const ValueTree& v, bool wasAdded)
 		} sorter;
 
 		childNodes.addSorted(sorter, nc);
+		groupMemberWatchers.add(new GroupMemberWatcher(*this, v));
 
 		if(v[PropertyIds::Comment].toString().isNotEmpty())
 		{
@@ -794,11 +863,23 @@ void ContainerComponent::onChildAddRemove(const ValueTree& v, bool wasAdded)
 				break;
 			}
 		}
+
+		for (auto w : groupMemberWatchers)
+		{
+			if (w->data == v)
+			{
+				groupMemberWatchers.removeObject(w);
+				break;
+			}
+		}
 	}
 
 	if (auto d = findParentComponentOfClass<CableComponent::CableHolder>())
 		d->rebuildCables();
 
+	if (auto dn = findParentComponentOfClass<DspNetworkComponent>())
+		dn->triggerVisibilityUpdate();
+
 	cables.updatePins(*this);
 }
 
@@ -882,10 +963,7 @@ void ContainerComponent::onParameterPosition(const ValueTree& v, const Identifie
 
 void ContainerComponent::rebuildDescription()
 {
-	description.clear();
-	auto desc = Helpers::getSignalDescription(getValueTree());
-	description.setJustification(Justification::centredLeft);
-	description.append(desc, GLOBAL_FONT(), Helpers::getNodeColour(getValueTree()));
+	description = Helpers::getSignalDescription(getValueTree());
 }
 
 void ContainerComponent::expandParentsRecursive(Component& componentToShow, Rectangle<int> firstBoundsMightBeUnion, bool addMarginToFirst)
@@ -980,8 +1058,9 @@ void ContainerComponent::paint(Graphics& g)
 	if(lod == 0)
 	{
 		g.setColour(nodeColour);
+		g.setFont(GLOBAL_FONT());
 		tb.removeFromLeft(Helpers::ParameterMargin);
-		description.draw(g, tb.toFloat());
+		TextLayoutCache::drawText(g, description, tb.toFloat(), Justification::centredLeft);
 	}
 	
 	auto root = findParentComponentOfClass<DspNetworkComponent>();
@@ -1119,7 +1198,7 @@ bool ContainerComponent::selectGroup(Point<float> position)
 
 			for (auto cn : childNodes)
 			{
-				if (g->idList.contains(cn->getValueTree()[PropertyIds::ID].toString()))
+				if (g->isMember(cn->getValueTree()))
 				{
 					selection.addToSelection(cn);
 					ok = true;
@@ -1154,7 +1233,7 @@ scriptnode::ParameterComponent* ContainerComponent::getDraggableParameterCompone
 
 
 
-void ContainerComponent::CableSetup::CableDrawData::draw(Graphics& g, bool preferLines)
+void ContainerComponent::CableSetup::CableDrawData::addToGeometry(Geometry& geometry, bool preferLines)
 {
 	Path p;
 
@@ -1204,40 +1283,116 @@ void ContainerComponent::CableSetup::CableDrawData::draw(Graphics& g, bool prefe
 
 	auto strokeDepth = LayoutTools::getCableThickness(lod);
 
+	geometry.items.push_back({});
+	auto& item = geometry.items.back();
+	item.active = active;
+
 	if (lod == 0 && active)
 	{
+		item.shadowDots.addEllipse(Rectangle<float>(p1, p1).withSizeKeepingCentre(4.0f, 4.0f));
+		item.shadowDots.addEllipse(Rectangle<float>(p2, p2).withSizeKeepingCentre(4.0f, 4.0f));
 
-		g.setColour(Colours::black.withAlpha(0.7f));
-		g.fillEllipse(Rectangle<float>(p1, p1).withSizeKeepingCentre(4.0f, 4.0f));
-		g.fillEllipse(Rectangle<float>(p2, p2).withSizeKeepingCentre(4.0f, 4.0f));
-		g.strokePath(p, PathStrokeType(3.0f));
+		PathStrokeType(3.0f).createStrokedPath(item.shadow, p);
 		sp = PathStrokeType::rounded;
 	}
 
-	g.setColour(active ? c : c.withAlpha(0.2f));
-	g.strokePath(p, PathStrokeType(strokeDepth, PathStrokeType::beveled, sp));
+	PathStrokeType(strokeDepth, PathStrokeType::beveled, sp).createStrokedPath(item.cable, p);
 }
 
-void ContainerComponent::Group::draw(Graphics& g)
+ContainerComponent::InnerContainerIndex::InnerContainerIndex(Component* root, ContainerComponent* rootContainer)
 {
-	RectangleList<int> bounds;
+	addRecursive(root, rootContainer, -1, 0);
+}
 
-	LODManager::LODGraphics lg(g, parent);
+void ContainerComponent::InnerContainerIndex::addRecursive(Component* root, ContainerComponent* c, int parentIndex, int depth)
+{
+	if (!c->canBeInnerContainer())
+		return;
+
+	auto index = (int)items.size();
+	auto area = root->getLocalArea(c, c->getLocalBounds());
 
-	auto nodeTree = parent.getValueTree().getChildWithName(PropertyIds::Nodes);
+	items.push_back({ c, area, parentIndex, depth });
+	grid.add(area, index);
+
+	for (auto cn : c->childNodes)
+	{
+		if (auto childContainer = dynamic_cast<ContainerComponent*>(cn))
+			addRecursive(root, childContainer, index, depth + 1);
+	}
+}
 
-	Colour c;
+ContainerComponent* ContainerComponent::InnerContainerIndex::getInnerContainer(Point<int> rootPosition, Component* toSkip) const
+{
+	ContainerComponent* match = nullptr;
+	int matchDepth = -1;
 
-	for (auto n : nodeTree)
+	for (auto i : grid.getCandidates(rootPosition))
+	{
+		if (items[i].depth <= matchDepth)
+			continue;
+
+		auto valid = true;
+
+		// the point must be inside all parent containers and none of them must be skipped
+		for (auto p = i; p != -1 && valid; p = items[p].parentIndex)
+		{
+			const auto& item = items[p];
+			valid = item.container != nullptr && item.container.getComponent() != toSkip && item.area.contains(rootPosition);
+		}
+
+		if (valid)
+		{
+			match = items[i].container.getComponent();
+			matchDepth = items[i].depth;
+		}
+	}
+
+	return match;
+}
+
+void ContainerComponent::Group::onValue(const Identifier&, const var& newValue)
+{
+	idList = StringArray::fromTokens(newValue.toString(), ";", "");
+	idList.removeDuplicates(false);
+	idList.removeEmptyStrings();
+	idList.trim();
+
+	dirty = true;
+	parent.repaint();
+}
+
+void ContainerComponent::Group::update()
+{
+	members.clearQuick();
+	memberBounds = {};
+	colour = {};
+
+	RectangleList<int> bounds;
+
+	for (auto n : parent.getValueTree().getChildWithName(PropertyIds::Nodes))
 	{
 		if (idList.contains(n[PropertyIds::ID].toString()))
 		{
-			c = Helpers::getNodeColour(n);
+			members.add(n);
+			colour = Helpers::getNodeColour(n);
 			bounds.addWithoutMerging(Helpers::getBounds(n, true));
 		}
 	}
 
-	auto b = bounds.getBounds().expanded(10).toFloat();
+	memberBounds = bounds.getBounds();
+	dirty = false;
+}
+
+void ContainerComponent::Group::draw(Graphics& g)
+{
+	if (dirty)
+		update();
+
+	LODManager::LODGraphics lg(g, parent);
+
+	auto c = colour;
+	auto b = memberBounds.expanded(10).toFloat();
 
 	auto h = 20.0f + lg.getCurrentLOD() * 10;
 
@@ -1256,7 +1411,7 @@ void ContainerComponent::Group::draw(Graphics& g)
 
 	g.setColour(c);
 	g.setFont(f);
-	g.drawText(name, b.removeFromTop(h), Justification::centred);
+	TextLayoutCache::drawText(g, name, b.removeFromTop(h), Justification::centred);
 
 	
 }
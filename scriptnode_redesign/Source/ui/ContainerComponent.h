@@ -96,11 +96,39 @@ struct ContainerComponent : public NodeComponent,
 			isForcedVertical = type == CableSetup::ContainerType::Serial && Helpers::isVerticalContainer(parent.getValueTree());
 		}
 
+		/** The stroked outlines of all pins and signal cables of the container.
+
+			They are recalculated lazily when the pins are updated, the LOD changes or a
+			cable offset was changed, so paint() only needs to fill the paths. Every pin and
+			cable keeps its own paths so that they are filled in the original order and
+			overlapping outlines don't affect each other's winding.
+		*/
+		struct Geometry
+		{
+			struct Item
+			{
+				Path pin;
+				Path shadowDots;
+				Path shadow;
+				Path cable;
+				bool active = true;
+			};
+
+			void clear()
+			{
+				items.clear();
+			}
+
+			std::vector<Item> items;
+
+			int lod = -1;
+			bool dirty = true;
+		};
+
 		struct CableDrawData
 		{
 			Point<float> p1;
 			Point<float> p2;
-			Colour c;
 			int channelIndex;
 			int numChannels;
 			float cableOffset;
@@ -115,7 +143,7 @@ struct ContainerComponent : public NodeComponent,
 				channelIndex = channelIndex_;
 			}
 
-			void draw(Graphics& g, bool preferLines);
+			void addToGeometry(Geometry& geometry, bool preferLines);
 		};
 
 		bool isVertical() const
@@ -133,10 +161,16 @@ struct ContainerComponent : public NodeComponent,
 		float getCableOffset(int nodeIndex, Point<float> p1, Point<float> p2) const;
 		float getCableOffset(int nodeIndex, float maxWidth) const;
 
+		void rebuildGeometry(int newLod);
+
 		void draw(Graphics& g);
 
+		void onCableOffset(const ValueTree& v, const Identifier& id);
+
 		int lod = 0;
 		valuetree::PropertyListener branchListener;
+		valuetree::RecursivePropertyListener cableOffsetListener;
+		Geometry geometry;
 		ContainerComponent& parent;
 		bool isForcedVertical = false;
 		ContainerType type;
@@ -160,6 +194,7 @@ struct ContainerComponent : public NodeComponent,
 	void onFold(const Identifier& id, const var& newValue) override;
 	void onChildPositionUpdate(const ValueTree& v, const Identifier& id);
 	void onChildAddRemove(const ValueTree& v, bool wasAdded);
+	void onGroupMemberChange();
 	void onResize(const Identifier& id, const var& newValue);
 	void onIsVertical(const ValueTree& v, const Identifier& id);
 	void onParameterPosition(const ValueTree& v, const Identifier& id);
@@ -192,9 +227,15 @@ struct ContainerComponent : public NodeComponent,
 
 	ParameterComponent* getDraggableParameterComponent(int index);
 
+	bool canBeInnerContainer() const
+	{
+		return Helpers::isRootNode(getValueTree()) || !Helpers::isFoldedOrLockedContainer(getValueTree());
+	}
+
+	/** Returns the innermost container below the position. Folded containers and their children are ignored. */
 	ContainerComponent* getInnerContainer(Component* root, Point<int> rootPosition, Component* toSkip)
 	{
-		if(this == toSkip)
+		if(this == toSkip || !canBeInnerContainer())
 			return nullptr;
 
 		if (root->getLocalArea(this, getLocalBounds()).contains(rootPosition))
@@ -216,6 +257,32 @@ struct ContainerComponent : public NodeComponent,
 		return nullptr;
 	}
 
+	/** A spatial index of the containers below a root container that is created when a node drag starts
+		so that the hovered container can be found without walking the component tree on every mouse move.
+	*/
+	struct InnerContainerIndex
+	{
+		InnerContainerIndex(Component* root, ContainerComponent* rootContainer);
+
+		/** Returns the same container as getInnerContainer() on the root container. */
+		ContainerComponent* getInnerContainer(Point<int> rootPosition, Component* toSkip) const;
+
+	private:
+
+		void addRecursive(Component* root, ContainerComponent* c, int parentIndex, int depth);
+
+		struct Item
+		{
+			Component::SafePointer<ContainerComponent> container;
+			Rectangle<int> area;
+			int parentIndex;
+			int depth;
+		};
+
+		std::vector<Item> items;
+		RectangleGrid grid;
+	};
+
 	struct Group
 	{
 		Group(ContainerComponent& parent_, const ValueTree& v_) :
@@ -223,23 +290,45 @@ struct ContainerComponent : public NodeComponent,
 			v(v_),
 			parent(parent_)
 		{
-			auto list = v[PropertyIds::Value].toString();
-			idList = StringArray::fromTokens(list, ";", "");
-			idList.removeDuplicates(false);
-			idList.removeEmptyStrings();
-			idList.trim();
+			onValue(PropertyIds::Value, v[PropertyIds::Value]);
+			valueListener.setCallback(v, { PropertyIds::Value }, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onValue));
 		}
 
 		bool operator==(const ValueTree& other) const { return v == other; }
 
 		void draw(Graphics& g);
 
+		/** Call this when a node in the container was added, removed, renamed or resized. */
+		void markDirty() { dirty = true; }
+
+		bool isMember(const ValueTree& n)
+		{
+			if (dirty)
+				update();
+
+			return members.contains(n);
+		}
+
 		Rectangle<float> lastBounds;
 		ValueTree v;
 		ContainerComponent& parent;
 		String name;
 		StringArray idList;
 
+	private:
+
+		void onValue(const Identifier&, const var& newValue);
+
+		/** Resolves the member nodes and calculates the union of their bounds. */
+		void update();
+
+		valuetree::PropertyListener valueListener;
+
+		bool dirty = true;
+		Array<ValueTree> members;
+		Rectangle<int> memberBounds;
+		Colour colour;
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Group);
 	};
 
@@ -655,7 +744,18 @@ struct ContainerComponent : public NodeComponent,
 	valuetree::RecursivePropertyListener lockListener;
 	valuetree::RecursivePropertyListener breakoutListener;
 
-	AttributedString description;
+	/** Listens to the properties of a direct child node that change the bounds or the membership of a group. */
+	struct GroupMemberWatcher
+	{
+		GroupMemberWatcher(ContainerComponent& parent, const ValueTree& v);
+
+		ValueTree data;
+		valuetree::PropertyListener listener;
+	};
+
+	OwnedArray<GroupMemberWatcher> groupMemberWatchers;
+
+	String description;
 
 	JUCE_DECLARE_WEAK_REFERENCEABLE(ContainerComponent);
 	
@@ -41,6 +41,7 @@ DspNetworkComponent::DspNetworkComponent(PooledUIUpdater* updater, ZoomableViewp
 	CableHolder(networkTree),
 	Lasso(updater),
 	LODManager(zp),
+	networkIndex(NetworkIndex::getOrCreate(networkTree)),
 	data(networkTree)
 {
 	Helpers::migrateFeedbackConnections(data, true, nullptr);
@@ -82,6 +83,8 @@ DspNetworkComponent::DspNetworkComponent(PooledUIUpdater* updater, ZoomableViewp
 
 	auto b = Helpers::getBounds(rootContainer, false);
 	setSize(b.getWidth(), b.getHeight());
+
+	visibleAreaWatcher = new VisibleAreaWatcher(*this);
 }
 
 void DspNetworkComponent::onFold(const ValueTree& v, const Identifier& id)
@@ -89,6 +92,7 @@ void DspNetworkComponent::onFold(const ValueTree& v, const Identifier& id)
 	SafeAsyncCall::call<DspNetworkComponent>(*this, [](DspNetworkComponent& d)
 		{
 			d.rebuildCables();
+			d.triggerVisibilityUpdate();
 		});
 
 	return;
@@ -327,6 +331,10 @@ bool DspNetworkComponent::performAction(Action a)
 			{
 				getLassoSelection().deselectAll();
 
+#if SCRIPTNODE_BATCHED_CABLES
+				if (cableLayer != nullptr)
+					cableLayer->selectConnections(treeSelection);
+#else
 				callRecursive<CableComponent>(this, [&](CableComponent* c)
 					{
 						if (treeSelection.contains(c->getValueTree()))
@@ -334,6 +342,7 @@ bool DspNetworkComponent::performAction(Action a)
 
 						return false;
 					});
+#endif
 			});
 
 		return true;
@@ -666,48 +675,273 @@ Rectangle<int> DspNetworkComponent::getCurrentViewPosition() const
 	return s;
 }
 
-void DspNetworkComponent::findLassoItemsInArea(Array<SelectableComponent::WeakPtr>& itemsFound, const Rectangle<int>& area)
+void DspNetworkComponent::updateVirtualBodies()
+{
+#if SCRIPTNODE_VIRTUAL_BODIES
+	if (getParentComponent() == nullptr)
+		return;
+
+	auto area = getCurrentViewPosition();
+	getVisibilityIndex().updateBodies(area.expanded(VirtualBodyMargin), area.expanded(2 * VirtualBodyMargin));
+#endif
+}
+
+void DspNetworkComponent::updateActiveClients()
+{
+	if (getParentComponent() == nullptr)
+		return;
+
+	auto area = getCurrentViewPosition().expanded(ActivationMargin);
+
+	getVisibilityIndex().updateClients(area);
+
+#if SCRIPTNODE_BATCHED_CABLES
+	if (cableLayer != nullptr)
+		cableLayer->updateWatchers(area);
+#endif
+}
+
+DspNetworkComponent::VisibilityIndex& DspNetworkComponent::getVisibilityIndex()
+{
+	// the index only changes with the layout, so scrolling can reuse it
+	if (visibilityIndex == nullptr)
+		visibilityIndex = new VisibilityIndex(*this);
+
+	return *visibilityIndex;
+}
+
+void DspNetworkComponent::triggerVisibilityUpdate()
+{
+	visibilityIndex = nullptr;
+
+	if (visibleAreaWatcher != nullptr)
+		visibleAreaWatcher->triggerAsyncUpdate();
+}
+
+DspNetworkComponent::VisibleAreaWatcher::VisibleAreaWatcher(DspNetworkComponent& parent_) :
+	ComponentMovementWatcher(&parent_),
+	parent(parent_)
+{
+	triggerAsyncUpdate();
+}
+
+void DspNetworkComponent::VisibleAreaWatcher::handleAsyncUpdate()
+{
+	parent.updateVirtualBodies();
+	parent.updateActiveClients();
+}
+
+DspNetworkComponent::VisibilityIndex::VisibilityIndex(DspNetworkComponent& root_):
+	root(root_)
+{
+	Component::callRecursive<ProcessNodeComponent>(&root, [&](ProcessNodeComponent* pn)
+	{
+		if (!pn->hasVirtualContent())
+			return false;
+
+		auto index = (int)bodies.size();
+		bodies.push_back({ pn, root.getLocalArea(pn, pn->getLocalBounds()) });
+		bodyGrid.add(bodies.back().bounds, index);
+
+		if (pn->isContentActive())
+			activeBodies.push_back(index);
+
+		return false;
+	});
+
+	addClients(&root);
+}
+
+void DspNetworkComponent::VisibilityIndex::addClients(Component* parent)
+{
+	Component::callRecursive<VisibilityClient>(parent, [&](VisibilityClient* vc)
+	{
+		auto c = dynamic_cast<Component*>(vc);
+
+		auto index = (int)clients.size();
+		clients.push_back({ c, vc, root.getLocalArea(c, c->getLocalBounds()), c->isShowing() });
+		clientGrid.add(clients.back().bounds, index);
+
+		if (vc->isActive())
+			activeClients.push_back(index);
+
+		return false;
+	});
+}
+
+void DspNetworkComponent::VisibilityIndex::updateClients(Rectangle<int> area)
+{
+	std::vector<int> stillActive;
+	stillActive.reserve(activeClients.size());
+
+	auto update = [&](int i)
+	{
+		auto& c = clients[i];
+
+		if (c.component == nullptr)
+			return;
+
+		auto shouldBeActive = c.showing && area.intersects(c.bounds);
+		c.client->setActive(shouldBeActive);
+
+		if (shouldBeActive)
+			stillActive.push_back(i);
+	};
+
+	// only the active clients can be suspended...
+	for (auto i : activeClients)
+		update(i);
+
+	// ...and only the clients in the cells around the visible area can be activated
+	for (auto i : clientGrid.getCandidates(area))
+	{
+		if (clients[i].component != nullptr && !clients[i].client->isActive())
+			update(i);
+	}
+
+	activeClients = std::move(stillActive);
+}
+
+void DspNetworkComponent::VisibilityIndex::updateBodies(Rectangle<int> activeArea, Rectangle<int> keepArea)
 {
-	callRecursive<SelectableComponent>(this, [&](SelectableComponent* nc)
+	std::vector<int> stillActive;
+	stillActive.reserve(activeBodies.size());
+
+	// only the active bodies can be released...
+	for (auto i : activeBodies)
+	{
+		auto& b = bodies[i];
+
+		if (b.node == nullptr)
+			continue;
+
+		if (keepArea.intersects(b.bounds))
+			stillActive.push_back(i);
+		else
+			b.node->setContentActive(false);
+	}
+
+	// ...and only the nodes in the cells around the visible area can be activated
+	for (auto i : bodyGrid.getCandidates(activeArea))
+	{
+		auto& b = bodies[i];
+
+		if (b.node == nullptr || b.node->isContentActive())
+			continue;
+
+		if (activeArea.intersects(b.bounds) && b.node->isShowing())
 		{
-			auto asComponent = dynamic_cast<Component*>(nc);
+			b.node->setContentActive(true);
+			stillActive.push_back(i);
 
-			if (!asComponent->isShowing())
-				return false;
+			if (auto body = b.node->getExtraBody())
+				addClients(body);
+		}
+	}
 
-			if (auto c = dynamic_cast<CableBase*>(nc))
-			{
-				if (!itemsFound.contains(nc))
-				{
-					auto la = c->getLocalArea(this, area.toFloat());
+	activeBodies = std::move(stillActive);
+}
 
-					if (c->p.intersectsLine({ la.getTopLeft(), la.getBottomRight() }))
-					{
-						itemsFound.add(nc);
-					}
-				}
-			}
-			else
-			{
-				auto nb = getLocalArea(asComponent, asComponent->getLocalBounds());
+void DspNetworkComponent::findLassoItemsInArea(Array<SelectableComponent::WeakPtr>& itemsFound, const Rectangle<int>& area)
+{
+	// the components don't move while the lasso is dragged so we can reuse the index until the mouse is released
+	if (lassoIndex == nullptr)
+		lassoIndex = new LassoIndex(*this);
 
-				if (area.intersects(nb) && !nb.contains(area))
-				{
-					auto p = asComponent->findParentComponentOfClass<SelectableComponent>();
+	lassoIndex->findItems(*this, itemsFound, area);
 
-					while (p != nullptr)
-					{
-						itemsFound.removeAllInstancesOf(p);
-						asComponent = dynamic_cast<Component*>(p);
-						p = asComponent->findParentComponentOfClass<SelectableComponent>();
-					}
+#if SCRIPTNODE_BATCHED_CABLES
+	if (cableLayer != nullptr)
+		cableLayer->findLassoItems(itemsFound, area);
+#endif
+}
 
-					itemsFound.addIfNotAlreadyThere(nc);
-				}
-			}
+void DspNetworkComponent::lassoStateChanged(SelectableComponent::LassoState state)
+{
+	if (state != SelectableComponent::LassoState::Drag)
+		lassoIndex = nullptr;
+}
+
+DspNetworkComponent::LassoIndex::LassoIndex(DspNetworkComponent& root)
+{
+	std::map<SelectableComponent*, int> indexes;
+
+	Component::callRecursive<SelectableComponent>(&root, [&](SelectableComponent* nc)
+	{
+		auto asComponent = dynamic_cast<Component*>(nc);
+
+		Item item;
+		item.item = nc;
+		item.cable = dynamic_cast<CableBase*>(nc);
+		item.parentIndex = -1;
 
+#if SCRIPTNODE_BATCHED_CABLES
+		// the cable layer checks its cables (and returns their proxies)
+		if (dynamic_cast<CableComponent*>(nc) != nullptr)
 			return false;
-		});
+#endif
+
+		if (!asComponent->isShowing())
+			return false;
+
+		if (item.cable != nullptr)
+			item.bounds = root.getLocalArea(item.cable, item.cable->p.getBounds()).getSmallestIntegerContainer();
+		else
+			item.bounds = root.getLocalArea(asComponent, asComponent->getLocalBounds());
+
+		if (auto p = asComponent->findParentComponentOfClass<SelectableComponent>())
+		{
+			auto it = indexes.find(p);
+
+			if (it != indexes.end())
+				item.parentIndex = it->second;
+		}
+
+		auto index = (int)items.size();
+		indexes[nc] = index;
+		items.push_back(item);
+		grid.add(item.bounds, index);
+
+		return false;
+	});
+}
+
+void DspNetworkComponent::LassoIndex::findItems(DspNetworkComponent& root, Array<SelectableComponent::WeakPtr>& itemsFound, const Rectangle<int>& area) const
+{
+	// the candidates are sorted so this keeps the order of the component hierarchy
+	auto candidates = grid.getCandidates(area);
+
+	std::vector<int> hits;
+	std::vector<bool> hasSelectedChild(items.size(), false);
+
+	for (auto i : candidates)
+	{
+		const auto& item = items[i];
+
+		if (item.item == nullptr)
+			continue;
+
+		if (item.cable != nullptr)
+		{
+			auto la = item.cable->getLocalArea(&root, area.toFloat());
+
+			if (item.cable->p.intersectsLine({ la.getTopLeft(), la.getBottomRight() }))
+				hits.push_back(i);
+		}
+		else if (area.intersects(item.bounds) && !item.bounds.contains(area))
+		{
+			for (auto p = item.parentIndex; p != -1; p = items[p].parentIndex)
+				hasSelectedChild[p] = true;
+
+			hits.push_back(i);
+		}
+	}
+
+	for (auto i : hits)
+	{
+		if (!hasSelectedChild[i])
+			itemsFound.addIfNotAlreadyThere(items[i].item);
+	}
 }
 
 void DspNetworkComponent::setIsDragged(NodeComponent* nc)
@@ -740,6 +974,7 @@ void DspNetworkComponent::clearDraggedComponents()
 		c.addToParent(*this);
 
 	currentlyDraggedComponents.clear();
+	hoverIndex = nullptr;
 
 	if(currentlyHoveredContainer != nullptr)
 		currentlyHoveredContainer->repaint();
@@ -1113,7 +1348,7 @@ struct DspNetworkComponent::CreateNodePopup : public Component,
 				itemBounds.removeFromLeft(5.0f);
 
 				g.setColour(Colours::white.withAlpha(0.8f));
-				g.drawText(itemName, itemBounds.removeFromLeft(bf.getStringWidthFloat(itemName) + 2.0f), Justification::left);
+				TextLayoutCache::drawText(g, itemName, itemBounds.removeFromLeft(TextLayoutCache::getStringWidth(bf, itemName) + 2.0f), Justification::left);
 				g.setColour(Colours::white.withAlpha(0.5f));
 			}
 			else
@@ -1126,16 +1361,16 @@ struct DspNetworkComponent::CreateNodePopup : public Component,
 
 
 				g.setColour(Helpers::getFadeColour(idx, fIds.size()).withAlpha(1.0f));
-				g.drawText(factory, itemBounds.removeFromLeft(bf.getStringWidthFloat(factory) + 2.0f), Justification::left);
+				TextLayoutCache::drawText(g, factory, itemBounds.removeFromLeft(TextLayoutCache::getStringWidth(bf, factory) + 2.0f), Justification::left);
 				g.setColour(Colours::white.withAlpha(0.8f));
-				g.drawText(nodeId, itemBounds.removeFromLeft(bf.getStringWidthFloat(nodeId) + 2.0f), Justification::left);
+				TextLayoutCache::drawText(g, nodeId, itemBounds.removeFromLeft(TextLayoutCache::getStringWidth(bf, nodeId) + 2.0f), Justification::left);
 				g.setColour(Colours::white.withAlpha(0.5f));
 			}
 
 			itemBounds.removeFromLeft(5.0f);
 
 			g.setFont(GLOBAL_FONT());
-			g.drawText(description, itemBounds, Justification::left);
+			TextLayoutCache::drawText(g, description, itemBounds, Justification::left);
 		}
 
 	} laf;
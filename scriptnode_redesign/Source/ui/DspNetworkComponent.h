@@ -102,6 +102,8 @@ struct DspNetworkComponent : public Component,
 	void findLassoItemsInArea(Array<SelectableComponent::WeakPtr>& itemsFound,
 		const Rectangle<int>& area) override;
 
+	void lassoStateChanged(SelectableComponent::LassoState state) override;
+
 	void setIsDragged(NodeComponent* nc);
 	void clearDraggedComponents();
 	void resetDraggedBounds();
@@ -110,6 +112,7 @@ struct DspNetworkComponent : public Component,
 	static void switchRootNode(Component* c, ValueTree newRoot);
 
 	Component::SafePointer<ContainerComponent> currentlyHoveredContainer;
+	ScopedPointer<ContainerComponent::InnerContainerIndex> hoverIndex;
 	ScopedPointer<ContainerComponent> rootComponent;
 
 	void showCreateConnectionPopup(Point<int> pos);
@@ -117,6 +120,19 @@ struct DspNetworkComponent : public Component,
 
 	ValueTree getRootTree() const { return rootComponent->getValueTree(); }
 
+	/** Creates the bodies and parameter sliders of the process nodes close to the visible area and releases
+		the ones that are far away. This does nothing unless SCRIPTNODE_VIRTUAL_BODIES is enabled. */
+	void updateVirtualBodies();
+
+	/** Activates the VisibilityClients that are showing and close to the visible area and suspends all others. */
+	void updateActiveClients();
+
+	/** Call this when the layout changes. This rebuilds the visibility index and coalesces multiple
+		requests into a single update of the virtual bodies and the visibility clients. */
+	void triggerVisibilityUpdate();
+
+	void cablesRebuilt() override { triggerVisibilityUpdate(); }
+
 private:
 
 	struct CreateConnectionPopup;
@@ -154,13 +170,102 @@ private:
 		std::vector<Item> items;
 	};
 
+	/** A grid of all visible selectable components that is created when the lasso starts
+		so that dragging the lasso only has to check the components in the cells below the area.
+	*/
+	struct LassoIndex
+	{
+		LassoIndex(DspNetworkComponent& root);
+
+		void findItems(DspNetworkComponent& root, Array<SelectableComponent::WeakPtr>& itemsFound, const Rectangle<int>& area) const;
+
+	private:
+
+		struct Item
+		{
+			SelectableComponent::WeakPtr item;
+			Rectangle<int> bounds;
+			CableBase* cable;
+			int parentIndex;
+		};
+
+		std::vector<Item> items;
+		RectangleGrid grid;
+	};
+
+	/** A grid of the process nodes with a virtual body and the visibility clients that is created
+		when the layout changes. Scrolling only has to check the items in the cells around the visible
+		area and the items that are currently active instead of walking the entire component tree. */
+	struct VisibilityIndex
+	{
+		VisibilityIndex(DspNetworkComponent& root);
+
+		void updateBodies(Rectangle<int> activeArea, Rectangle<int> keepArea);
+		void updateClients(Rectangle<int> area);
+
+	private:
+
+		/** Adds the clients below the given component (this is called for every new body). */
+		void addClients(Component* parent);
+
+		struct Client
+		{
+			Component::SafePointer<Component> component;
+			VisibilityClient* client;
+			Rectangle<int> bounds;
+			bool showing;
+		};
+
+		struct Body
+		{
+			Component::SafePointer<ProcessNodeComponent> node;
+			Rectangle<int> bounds;
+		};
+
+		DspNetworkComponent& root;
+
+		std::vector<Body> bodies;
+		std::vector<int> activeBodies;
+		RectangleGrid bodyGrid;
+
+		std::vector<Client> clients;
+		std::vector<int> activeClients;
+		RectangleGrid clientGrid;
+	};
+
+	VisibilityIndex& getVisibilityIndex();
+
+	/** Watches the position of this component within the viewport (and its parents) and
+		updates the virtual bodies and the visibility clients when the visible area changes. */
+	struct VisibleAreaWatcher : public ComponentMovementWatcher,
+								public AsyncUpdater
+	{
+		VisibleAreaWatcher(DspNetworkComponent& parent_);
+
+		void componentMovedOrResized(bool, bool) override { triggerAsyncUpdate(); }
+		void componentPeerChanged() override {}
+		void componentVisibilityChanged() override { parent.triggerVisibilityUpdate(); }
+		void handleAsyncUpdate() override;
+
+		DspNetworkComponent& parent;
+	};
+
+	static constexpr int VirtualBodyMargin = 400;
+	static constexpr int ActivationMargin = 100;
+
+	ScopedPointer<VisibleAreaWatcher> visibleAreaWatcher;
+
 	bool editMode = false;
 
+	ScopedPointer<LassoIndex> lassoIndex;
+	ScopedPointer<VisibilityIndex> visibilityIndex;
+
 	Array<DraggedNode> currentlyDraggedComponents;
 	std::map<char, SnapShot> snapshotPositions;
 
 	Path currentBuildPath;
 
+	NetworkIndex::Ptr networkIndex;
 	ValueTree data;
 
 	Point<int> pos;
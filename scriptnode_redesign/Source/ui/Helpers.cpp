@@ -40,7 +40,7 @@ ScriptnodeExtraComponentBase* DummyBody::createDummyComponent(const String& path
 {
 	auto nodeType = path.fromFirstOccurrenceOf(".", false, false);
 
-#define RETURN_IMAGE(name) if (nodeType == #name) return new DummyBody(ImageCache::getFromMemory(BinaryData::name##_png, BinaryData::name##_png##Size));
+#define RETURN_IMAGE(name) if (nodeType == #name) return new DummyBody(#name, ImageCache::getFromMemory(BinaryData::name##_png, BinaryData::name##_png##Size));
 
 	RETURN_IMAGE(expr);
 	RETURN_IMAGE(cable_expr);
@@ -61,15 +61,315 @@ ScriptnodeExtraComponentBase* DummyBody::createDummyComponent(const String& path
 	return nullptr;
 }
 
-DummyBody::DummyBody(const Image& img_) :
-	img(img_)
+DummyBody::MipMap::Ptr DummyBody::MipMap::getOrCreate(const String& name, const Image& img)
+{
+	// only keep weak references so that the images are released with the last body
+	static std::map<String, WeakReference<MipMap>> mipMaps;
+
+	if (auto existing = mipMaps[name].get())
+		return existing;
+
+	Ptr newMipMap = new MipMap(img);
+	mipMaps[name] = newMipMap.get();
+	return newMipMap;
+}
+
+DummyBody::MipMap::MipMap(const Image& img)
+{
+	levels.add(img);
+}
+
+const Image& DummyBody::MipMap::getLevelForWidth(int targetWidth, bool allowSmaller)
+{
+	int index = 0;
+
+	while (getLevel(index).getWidth() / 2 >= targetWidth && getLevel(index).getWidth() > 1)
+		index++;
+
+	if (allowSmaller && getLevel(index).getWidth() > 1)
+	{
+		auto smaller = getLevel(index + 1).getWidth();
+
+		if (targetWidth - smaller < getLevel(index).getWidth() - targetWidth)
+			index++;
+	}
+
+	return getLevel(index);
+}
+
+const Image& DummyBody::MipMap::getLevel(int index)
+{
+	while (levels.size() <= index)
+	{
+		auto& last = levels.getReference(levels.size() - 1);
+		auto w = jmax(1, last.getWidth() / 2);
+		auto h = jmax(1, last.getHeight() / 2);
+
+		levels.add(last.rescaled(w, h, Graphics::highResamplingQuality));
+	}
+
+	return levels.getReference(index);
+}
+
+DummyBody::DummyBody(const String& name, const Image& img_) :
+	img(img_),
+	mipMap(MipMap::getOrCreate(name, img_))
 {
 	setSize(img.getWidth() / 2, img.getHeight() / 2);
 }
 
 void DummyBody::paint(Graphics& g)
 {
-	g.drawImageWithin(img, 0, 0, getWidth(), getHeight(), RectanglePlacement::centred);
+	auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+	auto targetWidth = roundToInt((float)getWidth() * scale);
+
+	// the coarse LODs can use the closest level even if it's a bit too small
+	auto allowSmaller = LODManager::getLOD(*this) > 0;
+
+	auto& level = mipMap->getLevelForWidth(targetWidth, allowSmaller);
+
+	// the level is already close to the target size so a cheap resample is enough
+	g.setImageResamplingQuality(Graphics::lowResamplingQuality);
+	g.drawImageWithin(level, 0, 0, getWidth(), getHeight(), RectanglePlacement::centred);
+}
+
+NodeDescriptor::NodeDescriptor(const ValueTree& v)
+{
+	auto path = Helpers::getFactoryPath(v);
+	auto n = path.second;
+
+	if (path.first.isNotEmpty())
+		factoryId = Identifier(path.first);
+
+	if (n.isNotEmpty())
+		nodeId = Identifier(n);
+
+	if (path.first == "routing")
+		flags |= RoutingFactory;
+
+	if (n == "send")
+		flags |= Send;
+	else if (n == "receive")
+		flags |= Receive;
+	else if (n == "locked_mod")
+		flags |= LockedMod;
+
+	if (n == "split" || n == "multi")
+		flags |= VerticalByDefault;
+
+	if (n == "midichain" || n == "oversample" || n == "fix32_block")
+		flags |= AlwaysProcessing;
+
+	if (DataBaseHelpers::isSignalNode(v))
+		flags |= SignalNode;
+
+	if (path.first == "container")
+		category = Category::Container;
+	else if (hasFlag(Send) || hasFlag(Receive))
+		category = Category::Routable;
+	else if (hasFlag(SignalNode))
+		category = Category::Process;
+	else
+		category = Category::Cable;
+
+	if (n == "offline")
+		containerType = ContainerType::Offline;
+	else if (n == "midichain")
+		containerType = ContainerType::MidiChain;
+	else if (n == "modchain")
+		containerType = ContainerType::ModChain;
+	else if (n == "split")
+		containerType = ContainerType::Split;
+	else if (n == "multi")
+		containerType = ContainerType::Multi;
+	else if (n == "branch")
+		containerType = ContainerType::Branch;
+	else if (n == "sidechain")
+		containerType = ContainerType::SideChain;
+	else if (n == "soft_bypass")
+		containerType = ContainerType::SoftBypass;
+	else if (n.contains("fix"))
+		containerType = ContainerType::FixBlock;
+	else if (n.contains("frame"))
+		containerType = ContainerType::Frame;
+	else if (isContainer())
+		containerType = ContainerType::Serial;
+}
+
+const NodeDescriptor& NodeDescriptor::get(const ValueTree& v)
+{
+	static std::unordered_map<String, NodeDescriptor> descriptors;
+
+	auto path = v[PropertyIds::FactoryPath].toString();
+	auto it = descriptors.find(path);
+
+	if (it != descriptors.end())
+		return it->second;
+
+	return descriptors.emplace(path, NodeDescriptor(v)).first->second;
+}
+
+void RectangleGrid::add(Rectangle<int> b, int index)
+{
+	for (int x = b.getX() / CellSize; x <= b.getRight() / CellSize; x++)
+	{
+		for (int y = b.getY() / CellSize; y <= b.getBottom() / CellSize; y++)
+			cells[getCellKey(x, y)].add(index);
+	}
+}
+
+std::vector<int> RectangleGrid::getCandidates(Rectangle<int> area) const
+{
+	std::vector<int> candidates;
+
+	for (int x = area.getX() / CellSize; x <= area.getRight() / CellSize; x++)
+	{
+		for (int y = area.getY() / CellSize; y <= area.getBottom() / CellSize; y++)
+		{
+			auto it = cells.find(getCellKey(x, y));
+
+			if (it != cells.end())
+				candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	std::sort(candidates.begin(), candidates.end());
+	candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+	return candidates;
+}
+
+const Array<int>& RectangleGrid::getCandidates(Point<int> pos) const
+{
+	auto it = cells.find(getCellKey(pos.getX() / CellSize, pos.getY() / CellSize));
+
+	if (it != cells.end())
+		return it->second;
+
+	return noCandidates;
+}
+
+ModulationStream::ModulationStream(int capacity) :
+	mask((uint32)nextPowerOfTwo(jmax(2, capacity)) - 1)
+{
+	data.calloc(mask + 1);
+}
+
+int ModulationStream::push(const float* values, int numValues)
+{
+	auto w = writePosition.load(std::memory_order_relaxed);
+	auto r = readPosition.load(std::memory_order_acquire);
+
+	auto numFree = (int)(mask - (w - r));
+	auto numToWrite = jmin(numFree, numValues);
+
+	for (int i = 0; i < numToWrite; i++)
+		data[(w + (uint32)i) & mask] = values[i];
+
+	writePosition.store(w + (uint32)numToWrite, std::memory_order_release);
+	return numToWrite;
+}
+
+int ModulationStream::pop(float* destination, int maxNumValues)
+{
+	auto r = readPosition.load(std::memory_order_relaxed);
+	auto w = writePosition.load(std::memory_order_acquire);
+
+	auto numToRead = jmin((int)(w - r), maxNumValues);
+
+	for (int i = 0; i < numToRead; i++)
+		destination[i] = data[(r + (uint32)i) & mask];
+
+	readPosition.store(r + (uint32)numToRead, std::memory_order_release);
+	return numToRead;
+}
+
+int ModulationStream::getNumReady() const
+{
+	return (int)(writePosition.load(std::memory_order_acquire) - readPosition.load(std::memory_order_acquire));
+}
+
+size_t TextLayoutCache::KeyHash::operator()(const Key& k) const
+{
+	auto h = (size_t)k.text.hashCode64();
+	h ^= (size_t)k.font.getTypefaceName().hashCode64() + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= std::hash<float>()(k.font.getHeight()) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= std::hash<float>()(k.width) + 0x9e3779b9 + (h << 6) + (h >> 2);
+	h ^= (size_t)(k.font.getStyleFlags() | (k.justification << 8));
+	return h;
+}
+
+TextLayoutCache::Data& TextLayoutCache::getData()
+{
+	static Data d;
+	return d;
+}
+
+float TextLayoutCache::getStringWidth(const Font& f, const String& text)
+{
+	auto& d = getData();
+	Key k{ text, f, 0.0f, 0.0f, 0 };
+
+	auto it = d.widths.find(k);
+
+	if (it != d.widths.end())
+	{
+		d.stats.hits++;
+		return it->second;
+	}
+
+	d.stats.misses++;
+
+	if (d.widths.size() >= (size_t)MaxNumEntries)
+		d.widths.clear();
+
+	auto w = f.getStringWidthFloat(text);
+	d.widths.emplace(std::move(k), w);
+	return w;
+}
+
+void TextLayoutCache::drawText(Graphics& g, const String& text, Rectangle<float> area, Justification j)
+{
+	if (text.isEmpty() || area.isEmpty())
+		return;
+
+	auto& d = getData();
+	Key k{ text, g.getCurrentFont(), area.getWidth(), area.getHeight(), j.getFlags() };
+
+	auto it = d.arrangements.find(k);
+
+	if (it != d.arrangements.end())
+	{
+		d.stats.hits++;
+	}
+	else
+	{
+		d.stats.misses++;
+
+		if (d.arrangements.size() >= (size_t)MaxNumEntries)
+			d.arrangements.clear();
+
+		// same layout as Graphics::drawText(), but relative to the origin of the area
+		GlyphArrangement ga;
+		ga.addCurtailedLineOfText(k.font, text, 0.0f, 0.0f, area.getWidth(), true);
+		ga.justifyGlyphs(0, ga.getNumGlyphs(), 0.0f, 0.0f, area.getWidth(), area.getHeight(), j);
+
+		it = d.arrangements.emplace(std::move(k), std::move(ga)).first;
+	}
+
+	it->second.draw(g, AffineTransform::translation(area.getX(), area.getY()));
+}
+
+TextLayoutCache::Stats TextLayoutCache::getStats()
+{
+	return getData().stats;
+}
+
+void TextLayoutCache::clear()
+{
+	auto& d = getData();
+	d.arrangements.clear();
+	d.widths.clear();
+	d.stats = {};
 }
 
 std::pair<juce::String, juce::String> Helpers::getFactoryPath(const ValueTree& v)
@@ -98,6 +398,9 @@ juce::var Helpers::getNodeProperty(const ValueTree& v, const Identifier& id, con
 
 juce::String Helpers::getUniqueId(const String& prefix, const ValueTree& rootTree)
 {
+	if (auto ni = NetworkIndex::getFor(rootTree))
+		return ni->ids.getUniqueId(prefix);
+
 	int suffix = 0;
 
 	valuetree::Helpers::forEach(rootTree, [&](const ValueTree& v)
@@ -201,17 +504,12 @@ void Helpers::forEachVisibleNode(const ValueTree& rootNode, const std::function<
 
 bool Helpers::hasRoutableSignal(const ValueTree& v)
 {
-	static const StringArray routableNodes = {
-		"send",
-		"receive"
-	};
-
-	return routableNodes.contains(getFactoryPath(v).second);
+	return NodeDescriptor::get(v).category == NodeDescriptor::Category::Routable;
 }
 
 bool Helpers::isProcessNode(const ValueTree& v)
 {
-	return DataBaseHelpers::isSignalNode(v);
+	return NodeDescriptor::get(v).hasFlag(NodeDescriptor::SignalNode);
 }
 
 bool Helpers::isVerticalContainer(const ValueTree& v)
@@ -222,7 +520,7 @@ bool Helpers::isVerticalContainer(const ValueTree& v)
 bool Helpers::isContainerNode(const ValueTree& v)
 {
 	jassert(v.getType() == PropertyIds::Node);
-	return getFactoryPath(v).first == "container";
+	return NodeDescriptor::get(v).isContainer();
 }
 
 bool Helpers::isRootNode(const ValueTree& v)
@@ -249,21 +547,14 @@ bool Helpers::shouldBeVertical(const ValueTree& container)
 	if (isVerticalContainer(container))
 		return true;
 
-	auto p = getFactoryPath(container);
-
-	static const StringArray verticalContainers = {
-		"split",
-		"multi"
-	};
-
-	if (verticalContainers.contains(p.second))
-		return true;
-
-	return false;
+	return NodeDescriptor::get(container).hasFlag(NodeDescriptor::VerticalByDefault);
 }
 
 bool Helpers::isFoldedRecursive(const ValueTree& v)
 {
+	if (auto ni = NetworkIndex::getFor(v))
+		return ni->folds.isFolded(v);
+
 	if(isRootNode(v) || !v.isValid())
 		return false;
 
@@ -285,21 +576,14 @@ bool Helpers::isProcessingSignal(const ValueTree& v)
 {
 	auto bypassed = (bool)v[PropertyIds::Bypassed];
 
-	if(isContainerNode(v))
-	{
-		
-		auto container = getFactoryPath(v).second;
+	const auto& d = NodeDescriptor::get(v);
 
-		if(container == "offline")
+	if(d.isContainer())
+	{
+		if(d.containerType == NodeDescriptor::ContainerType::Offline)
 			return false;
 
-		static const StringArray switchers = {
-			"midichain",
-			"oversample",
-			"fix32_block"
-		};
-
-		if(switchers.contains(container))
+		if(d.hasFlag(NodeDescriptor::AlwaysProcessing))
 			return true;
 
 		return !bypassed;
@@ -391,11 +675,11 @@ juce::Colour Helpers::getNodeColour(const ValueTree& v)
 	if(v.getParent().getType() == PropertyIds::Network)
 		return Colour(0xFF305555);
 
-	auto t = getFactoryPath(v);
+	const auto& d = NodeDescriptor::get(v);
 
-	if (t.second == "midichain")
+	if (d.containerType == NodeDescriptor::ContainerType::MidiChain)
 		return Colour(0xFFC65638);
-	if (t.second == "modchain")
+	if (d.containerType == NodeDescriptor::ContainerType::ModChain)
 		return Colour(0xffbe952c);
 
 	auto c = (int64)v[PropertyIds::NodeColour];
@@ -403,7 +687,7 @@ juce::Colour Helpers::getNodeColour(const ValueTree& v)
 	if (c != 0)
 		return Colour((uint32)c);
 
-	if (isContainerNode(v))
+	if (d.isContainer())
 		return Colour(0xFF777777);
 
 	return Colour(0xFF666666);
@@ -427,31 +711,32 @@ juce::String Helpers::getSignalDescription(const ValueTree& container)
 {
 	jassert(isContainerNode(container));
 
-	auto path = getFactoryPath(container).second;
+	using CT = NodeDescriptor::ContainerType;
+	auto type = NodeDescriptor::get(container).containerType;
 
 	auto forceSerial = (bool)container[PropertyIds::Bypassed];
 
 	auto ch =  " (" + String(getNumChannels(container)) + " ch.)";
 
-	if(path == "offline")
+	if(type == CT::Offline)
 		return "No signal in this container";
 
-	if(!forceSerial && path == "midichain")
+	if(!forceSerial && type == CT::MidiChain)
 		return "Signal with MIDI events";
 
-	if(!forceSerial && path == "modchain")
+	if(!forceSerial && type == CT::ModChain)
 		return "Monophonic Control signal";
 
-	if(path == "split")
+	if(type == CT::Split)
 		return "Copy & Mix signal" + ch;
 
-	if(path == "multi")
+	if(type == CT::Multi)
 		return "Split multichchannel signal" + ch;
 
-	if(!forceSerial && path.contains("fix"))
+	if(!forceSerial && type == CT::FixBlock)
 		return "Split Audio buffer into 32 samples";
 
-	if(!forceSerial && path.contains("frame"))
+	if(!forceSerial && type == CT::Frame)
 		return "Process the signal for each sample";
 
 	return "Signal input" + ch;
@@ -514,6 +799,9 @@ Rectangle<int> Helpers::getBounds(const ValueTree& v, bool includingComment)
 
 Rectangle<int> Helpers::getBoundsInRoot(const ValueTree& v, bool includingComment)
 {
+	if (auto ni = NetworkIndex::getFor(v))
+		return ni->bounds.getBoundsInRoot(v, includingComment);
+
 	auto b = getBounds(v, includingComment).withPosition({});
 
 	auto p = v;
@@ -685,11 +973,11 @@ void Helpers::updateChannelRecursive(ValueTree v, int numChannels, UndoManager*
 {
 	jassert(v.getType() == PropertyIds::Node);
 
-	auto path = getFactoryPath(v);
+	auto type = NodeDescriptor::get(v).containerType;
 
-	auto isMulti = path.second == "multi";
-	auto isSideChain = path.second == "sidechain";
-	auto isModChain = path.second == "modchain";
+	auto isMulti = type == NodeDescriptor::ContainerType::Multi;
+	auto isSideChain = type == NodeDescriptor::ContainerType::SideChain;
+	auto isModChain = type == NodeDescriptor::ContainerType::ModChain;
 
 	if (isSideChain)
 		numChannels *= 2;
@@ -718,7 +1006,7 @@ void Helpers::migrateFeedbackConnections(ValueTree root, bool createConnections,
 {
 	valuetree::Helpers::forEach(root, [&](ValueTree& v)
 	{
-		if(v.getType() == PropertyIds::Node && v[PropertyIds::FactoryPath].toString() == "routing.send")
+		if(ParameterHelpers::isRoutingSendNode(v))
 		{
 			if(!createConnections)
 			{
@@ -813,14 +1101,19 @@ void Helpers::resetLayoutRecursive(ValueTree root, ValueTree& child, UndoManager
 
 juce::Path Helpers::createPinHole()
 {
-	Path pin;
-
 	static const unsigned char pathData[] = { 110,109,78,128,38,68,28,209,44,67,108,0,128,69,68,172,104,116,67,108,0,128,69,68,200,203,193,67,108,78,128,38,68,114,151,229,67,108,0,128,7,68,200,203,193,67,108,0,128,7,68,172,104,116,67,108,78,128,38,68,28,209,44,67,99,109,78,128,38,68,228,3,107,67,
 98,182,83,27,68,228,3,107,67,56,65,18,68,210,166,135,67,56,65,18,68,0,0,158,67,98,56,65,18,68,46,89,180,67,182,83,27,68,14,126,198,67,78,128,38,68,14,126,198,67,98,228,172,49,68,14,126,198,67,100,191,58,68,46,89,180,67,100,191,58,68,0,0,158,67,98,100,
 191,58,68,210,166,135,67,228,172,49,68,228,3,107,67,78,128,38,68,228,3,107,67,99,109,78,128,38,68,40,142,132,67,98,250,133,45,68,40,142,132,67,58,57,51,68,228,244,143,67,58,57,51,68,0,0,158,67,98,58,57,51,68,26,11,172,67,250,133,45,68,216,113,183,67,
 78,128,38,68,216,113,183,67,98,162,122,31,68,216,113,183,67,96,199,25,68,26,11,172,67,96,199,25,68,0,0,158,67,98,96,199,25,68,228,244,143,67,162,122,31,68,40,142,132,67,78,128,38,68,40,142,132,67,99,101,0,0 };
 
-	pin.loadPathFromData(pathData, sizeof(pathData));
+	// parse the path data only once, callers get a copy of the prototype
+	static const Path pin = []()
+	{
+		Path p;
+		p.loadPathFromData(pathData, sizeof(pathData));
+		return p;
+	}();
+
 	return pin;
 }
 
@@ -918,17 +1211,17 @@ juce::ValueTree ParameterHelpers::findConnectionParent(const ValueTree& con)
 
 bool ParameterHelpers::isRoutingReceiveNode(const ValueTree& v)
 {
-	return v.getType() == PropertyIds::Node && v[PropertyIds::FactoryPath].toString() == "routing.receive";
+	return v.getType() == PropertyIds::Node && NodeDescriptor::get(v).isRoutingReceive();
 }
 
 bool ParameterHelpers::isRoutingSendNode(const ValueTree& v)
 {
-	return v.getType() == PropertyIds::Node && v[PropertyIds::FactoryPath].toString() == "routing.send";
+	return v.getType() == PropertyIds::Node && NodeDescriptor::get(v).isRoutingSend();
 }
 
 bool ParameterHelpers::isSoftBypassNode(const ValueTree& v)
 {
-	return v.getType() == PropertyIds::Node && v[PropertyIds::FactoryPath].toString() == "container.soft_bypass";
+	return v.getType() == PropertyIds::Node && NodeDescriptor::get(v).isSoftBypass();
 }
 
 bool ParameterHelpers::isNodeConnection(const ValueTree& con)
@@ -992,23 +1285,30 @@ Array<juce::ValueTree> ParameterHelpers::getAutomatedChildParameters(ValueTree c
 
 juce::String ParameterHelpers::getParameterPath(const ValueTree& v)
 {
-	String s;
+	auto ids = getParameterPathIds(v);
+	return ids.first.toString() + "." + ids.second.toString();
+}
+
+std::pair<juce::var, juce::var> ParameterHelpers::getParameterPathIds(const ValueTree& v)
+{
+	static const var feedbackInput("FeedbackInput");
+	static const var bypassed("Bypassed");
 
 	if(isRoutingReceiveNode(v))
 	{
-		return v[PropertyIds::ID].toString() + "." + "FeedbackInput";
+		return { v[PropertyIds::ID], feedbackInput };
 	}
 	if(isSoftBypassNode(v))
 	{
-		return v[PropertyIds::ID].toString() + "." + "Bypassed";
+		return { v[PropertyIds::ID], bypassed };
 	}
 	if (v.getType() == PropertyIds::Connection)
 	{
-		return v[PropertyIds::NodeId].toString() + "." + v[PropertyIds::ParameterId].toString();
+		return { v[PropertyIds::NodeId], v[PropertyIds::ParameterId] };
 	}
 	else if (v.getType() == PropertyIds::Parameter)
 	{
-		return v.getParent().getParent()[PropertyIds::ID].toString() + "." + v[PropertyIds::ID].toString();
+		return { v.getParent().getParent()[PropertyIds::ID], v[PropertyIds::ID] };
 	}
 	else
 	{
@@ -1023,7 +1323,34 @@ juce::ValueTree ParameterHelpers::getConnection(const ValueTree& p)
 			p.getType() == PropertyIds::Connection || 
 			p.getType() == PropertyIds::Node);
 
-	auto path = getParameterPath(p);
+	ValueTree match;
+
+	if (auto ni = NetworkIndex::getFor(p))
+	{
+		match = ni->connections.getConnection(p);
+
+#if SCRIPTNODE_CHECK_NETWORK_INDEX
+		// if this hits, the index is out of sync with the network tree
+		jassert(match == getConnectionFromTree(p));
+#endif
+	}
+	else
+	{
+		match = getConnectionFromTree(p);
+	}
+
+	if(p.getType() == PropertyIds::Parameter)
+	{
+		// if this hits, the Automated flag is not set correctly...
+		jassert((bool)p[PropertyIds::Automated] == match.isValid());
+	}
+
+	return match;
+}
+
+juce::ValueTree ParameterHelpers::getConnectionFromTree(const ValueTree& p)
+{
+	auto path = getParameterPathIds(p);
 
 	Identifier typeToLookFor;
 
@@ -1045,9 +1372,7 @@ juce::ValueTree ParameterHelpers::getConnection(const ValueTree& p)
 	{
 		if(c.getType() == typeToLookFor)
 		{
-			auto cPath = getParameterPath(c);
-
-			if(cPath == path)
+			if(getParameterPathIds(c) == path)
 			{
 				match = c;
 				return true;
@@ -1057,12 +1382,6 @@ juce::ValueTree ParameterHelpers::getConnection(const ValueTree& p)
 		return false;
 	});
 
-	if(p.getType() == PropertyIds::Parameter)
-	{
-		// if this hits, the Automated flag is not set correctly...
-		jassert((bool)p[PropertyIds::Automated] == match.isValid());
-	}
-
 	return match;
 }
 
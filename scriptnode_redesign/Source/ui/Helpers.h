@@ -86,13 +86,36 @@ struct HoverShapeButton: public HiseShapeButton
 
 struct DummyBody : public ScriptnodeExtraComponentBase
 {
+	/** The downscaled versions of a body image. This is shared between all bodies with the same image
+		and the levels are created lazily when they are needed for the first time. */
+	struct MipMap : public ReferenceCountedObject
+	{
+		using Ptr = ReferenceCountedObjectPtr<MipMap>;
+
+		static Ptr getOrCreate(const String& name, const Image& img);
+
+		MipMap(const Image& img);
+
+		/** Returns the smallest level that has at least the given width (or the closest one if allowSmaller is true). */
+		const Image& getLevelForWidth(int targetWidth, bool allowSmaller);
+
+	private:
+
+		const Image& getLevel(int index);
+
+		Array<Image> levels;
+
+		JUCE_DECLARE_WEAK_REFERENCEABLE(MipMap);
+	};
+
 	static ScriptnodeExtraComponentBase* createDummyComponent(const String& path);
 
-	DummyBody(const Image& img_);
+	DummyBody(const String& name, const Image& img_);
 
 	void paint(Graphics& g) override;
 
 	Image img;
+	MipMap::Ptr mipMap;
 };
 
 
@@ -177,6 +200,259 @@ struct LayoutTools
 };
 
 
+/** A compact description of a node type that is derived from its FactoryPath.
+
+	The descriptors are created once per FactoryPath and shared between all nodes of that type, so the helper
+	functions that are used in paint() and layout routines don't have to split the FactoryPath string
+	(or query the node database) over and over again.
+*/
+struct NodeDescriptor
+{
+	enum class Category
+	{
+		Container,
+		Process,
+		Cable,
+		Routable,
+		numCategories
+	};
+
+	/** The container type derived from the node name (the part after the dot). */
+	enum class ContainerType
+	{
+		None,
+		Serial,
+		Split,
+		Multi,
+		Branch,
+		ModChain,
+		MidiChain,
+		SideChain,
+		Offline,
+		SoftBypass,
+		FixBlock,
+		Frame,
+		numContainerTypes
+	};
+
+	enum Flags
+	{
+		SignalNode = 1,			 // the node is part of the signal path (see DataBaseHelpers::isSignalNode)
+		RoutingFactory = 2,		 // the factory is "routing"
+		Send = 4,				 // the node name is "send"
+		Receive = 8,			 // the node name is "receive"
+		VerticalByDefault = 16,  // split & multi containers
+		AlwaysProcessing = 32,	 // midichain, oversample & fix32_block ignore the bypass state
+		LockedMod = 64			 // the node name is "locked_mod"
+	};
+
+	/** Returns the (shared) descriptor for the FactoryPath of the given node. */
+	static const NodeDescriptor& get(const ValueTree& v);
+
+	bool hasFlag(Flags f) const { return (flags & f) != 0; }
+
+	bool isContainer() const { return category == Category::Container; }
+	bool isRoutingSend() const { return hasFlag(RoutingFactory) && hasFlag(Send); }
+	bool isRoutingReceive() const { return hasFlag(RoutingFactory) && hasFlag(Receive); }
+	bool isSoftBypass() const { return isContainer() && containerType == ContainerType::SoftBypass; }
+
+	/** Whether the nodes with this factory path have an extra body. The UIFactory can't be queried
+		without creating the body, so this is unknown until the first body for the path was created. */
+	enum class ExtraBody
+	{
+		Unknown,
+		No,
+		Yes
+	};
+
+	ExtraBody getExtraBody() const { return extraBody; }
+
+	/** Call this with the result of the body creation (the descriptor is shared so this is a cached value). */
+	void setHasExtraBody(bool hasBody) const { extraBody = hasBody ? ExtraBody::Yes : ExtraBody::No; }
+
+	Category category = Category::Cable;
+	ContainerType containerType = ContainerType::None;
+	int flags = 0;
+
+	Identifier factoryId;
+	Identifier nodeId;
+
+private:
+
+	NodeDescriptor(const ValueTree& v);
+
+	mutable ExtraBody extraBody = ExtraBody::Unknown;
+};
+
+/** A lock-free single producer / single consumer queue of modulation values.
+
+	The producer (the audio thread or a simulation) pushes sample accurate or decimated values
+	and the UI thread pops them without any of the threads ever blocking. If the consumer can't keep up
+	the producer drops the values that don't fit into the queue.
+*/
+struct ModulationStream
+{
+	/** Creates a queue that can hold capacity - 1 values (the capacity is rounded up to a power of two). */
+	ModulationStream(int capacity);
+
+	/** Pushes the values and returns the number of values that were written. Producer thread only. */
+	int push(const float* values, int numValues);
+
+	/** Pops up to maxNumValues into the destination and returns the number of values that were read. Consumer thread only. */
+	int pop(float* destination, int maxNumValues);
+
+	/** Returns the number of values that are waiting to be consumed. */
+	int getNumReady() const;
+
+	/** The rate of the values in Hz. This must be set before the producer starts. */
+	double sampleRate = 0.0;
+
+private:
+
+	HeapBlock<float> data;
+	const uint32 mask;
+
+	std::atomic<uint32> writePosition { 0 };
+	std::atomic<uint32> readPosition { 0 };
+
+	JUCE_DECLARE_NON_COPYABLE(ModulationStream);
+};
+
+/** The source of the values in a ModulationStream.
+
+	The consumer starts the producer while it displays the values and stops it when it's hidden.
+	Subclass this in order to connect the stream to the audio thread (or any other source).
+*/
+struct ModulationProducer
+{
+	virtual ~ModulationProducer() = default;
+
+	/** Starts writing into the stream with its sample rate. This might be called when the producer is already running. */
+	virtual void startProducing(ModulationStream& stream) = 0;
+
+	/** Stops writing into the stream. The stream must not be accessed after this call returns. */
+	virtual void stopProducing() = 0;
+
+	/** Called on the UI thread when the range or the value of the modulated parameter changes. */
+	virtual void setTarget(const InvertableParameterRange&, double) {}
+};
+
+/** Base class for components with periodic updates that can be suspended while they are not visible.
+
+	The DspNetworkComponent checks all clients when the visible area, the fold state or the cables change and
+	suspends the ones that are hidden or scrolled away. A client should catch up with the changes that it has
+	missed when it is activated again.
+*/
+struct VisibilityClient
+{
+	virtual ~VisibilityClient() = default;
+
+	void setActive(bool shouldBeActive)
+	{
+		if (shouldBeActive != active)
+		{
+			active = shouldBeActive;
+			activeStateChanged();
+		}
+	}
+
+	bool isActive() const { return active; }
+
+protected:
+
+	/** Start or stop the updates here depending on isActive(). */
+	virtual void activeStateChanged() = 0;
+
+private:
+
+	bool active = true;
+};
+
+/** A uniform grid that stores the index of items with the cells that their bounds overlap.
+
+	This is used for hit tests during mouse gestures where the layout doesn't change, so
+	the grid is built once and then queried on every mouse event.
+*/
+struct RectangleGrid
+{
+	/** Adds the item index to all cells that overlap the bounds. */
+	void add(Rectangle<int> b, int index);
+
+	/** Returns the sorted indexes of all items whose cells overlap the area. */
+	std::vector<int> getCandidates(Rectangle<int> area) const;
+
+	/** Returns the sorted indexes of all items whose cell contains the position. */
+	const Array<int>& getCandidates(Point<int> pos) const;
+
+private:
+
+	static constexpr int CellSize = 256;
+
+	static int64 getCellKey(int x, int y) { return ((int64)x << 32) | (uint32)y; }
+
+	std::unordered_map<int64, Array<int>> cells;
+	Array<int> noCandidates;
+};
+
+/** A cache for the string widths and the laid out glyphs of the texts that are painted over and over again
+	(node titles, cable labels, group names...).
+
+	The glyphs are laid out once per (text, font, area size, justification) and then drawn with a translation, so
+	painting the same label at different positions reuses the arrangement. This must only be used from the message thread.
+*/
+struct TextLayoutCache
+{
+	struct Stats
+	{
+		int64 hits = 0;
+		int64 misses = 0;
+	};
+
+	/** Returns the width of the text (same as Font::getStringWidthFloat()). */
+	static float getStringWidth(const Font& f, const String& text);
+
+	/** Draws a single line of text like Graphics::drawText() using the current font of the graphics context. */
+	static void drawText(Graphics& g, const String& text, Rectangle<float> area, Justification j);
+
+	/** Returns the hit and miss count of the width and glyph lookups for profiling. */
+	static Stats getStats();
+
+	static void clear();
+
+private:
+
+	static constexpr int MaxNumEntries = 4096;
+
+	struct Key
+	{
+		bool operator==(const Key& other) const
+		{
+			return width == other.width && height == other.height && justification == other.justification &&
+				   text == other.text && font == other.font;
+		}
+
+		String text;
+		Font font;
+		float width;
+		float height;
+		int justification;
+	};
+
+	struct KeyHash
+	{
+		size_t operator()(const Key& k) const;
+	};
+
+	struct Data
+	{
+		std::unordered_map<Key, GlyphArrangement, KeyHash> arrangements;
+		std::unordered_map<Key, float, KeyHash> widths;
+		Stats stats;
+	};
+
+	static Data& getData();
+};
+
 struct Helpers
 {
 	enum class ConnectionType
@@ -203,6 +479,7 @@ struct Helpers
 
 	static std::pair<String, String> getFactoryPath(const ValueTree& v);
 	static var getNodeProperty(const ValueTree& v, const Identifier& id, const var& defaultValue);
+	/** Returns a unique node ID for the network (using the IdRegistry of the NetworkIndex if it exists). */
 	static String getUniqueId(const String& prefix, const ValueTree& rootTree);
 
 	static void setNodeProperty(ValueTree v, const Identifier& propertyName, const var& value, UndoManager* um);
@@ -285,10 +562,16 @@ struct ParameterHelpers
 
 	static String getParameterPath(const ValueTree& v);
 
-	/** Searches the entire network tree for a matching connection. */
+	/** Returns the node ID and parameter ID of the parameter path without concatenating them. */
+	static std::pair<var, var> getParameterPathIds(const ValueTree& v);
+
+	/** Returns the matching connection using the NetworkIndex (or a full walk if there is no index). */
 	static ValueTree getConnection(const ValueTree& p);
 
-	/** Searches the entire network tree for the matching parameter. */
+	/** Searches the entire network tree for a matching connection. */
+	static ValueTree getConnectionFromTree(const ValueTree& p);
+
+	/** Returns the matching parameter using the NetworkIndex (or a full walk if there is no index). */
 	static ValueTree getTarget(const ValueTree& con);
 	static double getThisValueOrFindDirectSource(juce::ValueTree ptree);
 
@@ -0,0 +1,837 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace scriptnode {
+using namespace hise;
+using namespace juce;
+
+NetworkIndex::Ptr NetworkIndex::getOrCreate(const ValueTree& networkTree)
+{
+	jassert(networkTree.getType() == PropertyIds::Network);
+
+	if (auto existing = getFor(networkTree))
+		return existing;
+
+	return new NetworkIndex(networkTree);
+}
+
+NetworkIndex* NetworkIndex::getFor(const ValueTree& v)
+{
+	auto& registry = getRegistry();
+
+	if (registry.isEmpty())
+		return nullptr;
+
+	auto root = v.getType() == PropertyIds::Network ? v : valuetree::Helpers::findParentWithType(v, PropertyIds::Network);
+
+	if (!root.isValid())
+		return nullptr;
+
+	for (auto ni : registry)
+	{
+		if (ni->networkTree == root)
+			return ni;
+	}
+
+	return nullptr;
+}
+
+NetworkIndex::NetworkIndex(const ValueTree& networkTree_) :
+	networkTree(networkTree_),
+	connections(networkTree_, paths),
+	pins(paths),
+	ids(networkTree_),
+	dependencies(networkTree_)
+{
+	getRegistry().add(this);
+	networkTree.addListener(this);
+}
+
+NetworkIndex::~NetworkIndex()
+{
+	networkTree.removeListener(this);
+	getRegistry().removeAllInstancesOf(this);
+}
+
+Array<NetworkIndex*>& NetworkIndex::getRegistry()
+{
+	JUCE_ASSERT_MESSAGE_THREAD;
+	static Array<NetworkIndex*> registry;
+	return registry;
+}
+
+void NetworkIndex::valueTreePropertyChanged(ValueTree& v, const Identifier& id)
+{
+	connections.onPropertyChange(v, id);
+	ids.onPropertyChange(v, id);
+	dependencies.onPropertyChange(v, id);
+	bounds.onPropertyChange(v, id);
+	folds.onPropertyChange(v, id);
+	values.onPropertyChange(v, id);
+
+	// the key of a pin depends on the node ID and whether it's a target on the factory path
+	if (id == PropertyIds::ID || id == PropertyIds::FactoryPath)
+		pins.markDirty();
+}
+
+void NetworkIndex::valueTreeChildAdded(ValueTree& parent, ValueTree& child)
+{
+	connections.add(child, true);
+	ids.add(child);
+	dependencies.add(child, true);
+	bounds.invalidate(child);
+	values.invalidateSources();
+
+	if (child.getType() == PropertyIds::Node || child.getType() == PropertyIds::Nodes)
+		folds.invalidate();
+}
+
+void NetworkIndex::valueTreeChildRemoved(ValueTree& parent, ValueTree& child, int)
+{
+	auto parentNode = parent.getType() == PropertyIds::Node ? parent : Helpers::findParentNode(parent);
+	connections.remove(child, parentNode);
+	ids.remove(child);
+	dependencies.remove(child);
+	bounds.invalidate(child);
+	values.invalidateSources();
+
+	if (child.getType() == PropertyIds::Node || child.getType() == PropertyIds::Nodes)
+		folds.invalidate();
+}
+
+NetworkIndex::PathTable::Handle NetworkIndex::PathTable::getHandle(const ValueTree& v)
+{
+	auto ids = ParameterHelpers::getParameterPathIds(v);
+	return getHandle(ids.first, ids.second);
+}
+
+NetworkIndex::PathTable::Handle NetworkIndex::PathTable::getHandle(const var& nodeId, const var& parameterId)
+{
+	auto n = toId(nodeId);
+	auto p = toId(parameterId);
+
+	// the identifiers are pooled so we can use the string addresses as key
+	Key k(n.getCharPointer().getAddress(), p.getCharPointer().getAddress());
+
+	auto it = handles.find(k);
+
+	if (it != handles.end())
+		return it->second;
+
+	auto h = (Handle)paths.size();
+	paths.push_back({ n, p });
+	handles[k] = h;
+	return h;
+}
+
+juce::String NetworkIndex::PathTable::getPath(Handle h) const
+{
+	if (isPositiveAndBelow(h, (int)paths.size()))
+		return paths[h].first.toString() + "." + paths[h].second.toString();
+
+	return {};
+}
+
+juce::Identifier NetworkIndex::PathTable::toId(const var& v)
+{
+	auto s = v.toString();
+
+	if (s.isEmpty())
+		return {};
+
+	return Identifier(s);
+}
+
+NetworkIndex::ConnectionIndex::ConnectionIndex(const ValueTree& networkTree, PathTable& paths_) :
+	root(networkTree),
+	paths(paths_)
+{
+	add(root, true);
+}
+
+juce::ValueTree NetworkIndex::ConnectionIndex::getConnection(const ValueTree& p)
+{
+	auto path = paths.getHandle(p);
+
+	if (p.getType() == PropertyIds::Connection)
+		return getFirstMatch(ParameterHelpers::isNodeConnection(p) ? nodes : parameters, path);
+
+	return getFirstMatch(connections, path);
+}
+
+void NetworkIndex::ConnectionIndex::add(const ValueTree& v, bool recursive)
+{
+	if (auto m = getMap(v.getType()))
+	{
+		auto path = getIndexPath(v);
+
+		if (path != PathTable::InvalidHandle)
+			(*m)[path].addIfNotAlreadyThere(v);
+	}
+
+	if (recursive)
+	{
+		for (auto c : v)
+			add(c, true);
+	}
+}
+
+void NetworkIndex::ConnectionIndex::remove(const ValueTree& v, ValueTree parentNode)
+{
+	if (v.getType() == PropertyIds::Node)
+		parentNode = v;
+
+	if (auto m = getMap(v.getType()))
+	{
+		// the parameter tree might already be detached from its node so we use the node from the recursion
+		auto path = v.getType() == PropertyIds::Parameter ? 
+			paths.getHandle(parentNode[PropertyIds::ID], v[PropertyIds::ID]) :
+			getIndexPath(v);
+
+		auto it = m->find(path);
+
+		if (it != m->end())
+		{
+			it->second.removeAllInstancesOf(v);
+
+			if (it->second.isEmpty())
+				m->erase(it);
+		}
+	}
+
+	for (auto c : v)
+		remove(c, parentNode);
+}
+
+void NetworkIndex::ConnectionIndex::onPropertyChange(const ValueTree& v, const Identifier& id)
+{
+	auto t = v.getType();
+
+	if (t == PropertyIds::Connection && (id == PropertyIds::NodeId || id == PropertyIds::ParameterId))
+		add(v, false);
+	else if (t == PropertyIds::Parameter && id == PropertyIds::ID)
+		add(v, false);
+	else if (t == PropertyIds::Node && (id == PropertyIds::ID || id == PropertyIds::FactoryPath))
+	{
+		add(v, false);
+
+		for (auto p : v.getChildWithName(PropertyIds::Parameters))
+			add(p, false);
+	}
+}
+
+NetworkIndex::PathTable::Handle NetworkIndex::ConnectionIndex::getIndexPath(const ValueTree& v)
+{
+	auto t = v.getType();
+
+	if (t == PropertyIds::Connection)
+		return paths.getHandle(v);
+
+	if (t == PropertyIds::Parameter && v.getParent().getParent().getType() == PropertyIds::Node)
+		return paths.getHandle(v);
+
+	if (ParameterHelpers::isRoutingReceiveNode(v) || ParameterHelpers::isSoftBypassNode(v))
+		return paths.getHandle(v);
+
+	return PathTable::InvalidHandle;
+}
+
+NetworkIndex::ConnectionIndex::Map* NetworkIndex::ConnectionIndex::getMap(const Identifier& type)
+{
+	if (type == PropertyIds::Connection)
+		return &connections;
+	if (type == PropertyIds::Parameter)
+		return &parameters;
+	if (type == PropertyIds::Node)
+		return &nodes;
+
+	return nullptr;
+}
+
+juce::ValueTree NetworkIndex::ConnectionIndex::getFirstMatch(Map& m, PathTable::Handle path)
+{
+	auto it = m.find(path);
+
+	if (it == m.end())
+		return {};
+
+	auto& bucket = it->second;
+
+	for (int i = 0; i < bucket.size(); i++)
+	{
+		auto c = bucket.getReference(i);
+
+		if (c.isAChildOf(root) && getIndexPath(c) == path)
+			return c;
+
+		// the tree was removed or renamed since it was added
+		bucket.remove(i--);
+	}
+
+	m.erase(it);
+	return {};
+}
+
+void NetworkIndex::PinRegistry::registerPin(CablePinBase* p)
+{
+	pins.add(p);
+	dirty = true;
+}
+
+void NetworkIndex::PinRegistry::unregisterPin(CablePinBase* p)
+{
+	pins.removeFirstMatchingValue(p);
+	dirty = true;
+}
+
+const Array<CablePinBase*>& NetworkIndex::PinRegistry::getTargets(const ValueTree& con, Helpers::ConnectionType ct)
+{
+	if (dirty)
+		rebuild();
+
+	auto key = paths.getHandle(con[PropertyIds::NodeId], con[PropertyIds::ParameterId]);
+	auto& m = targets[(int)ct];
+	auto it = m.find(key);
+
+	if (it != m.end())
+		return it->second;
+
+	return noTargets;
+}
+
+const Array<CablePinBase*>& NetworkIndex::PinRegistry::getPinsForNode(const ValueTree& nodeTree)
+{
+	if (dirty)
+		rebuild();
+
+	auto it = nodePins.find(paths.getHandle(nodeTree[PropertyIds::ID], var()));
+
+	if (it != nodePins.end())
+		return it->second;
+
+	return noTargets;
+}
+
+void NetworkIndex::PinRegistry::rebuild()
+{
+	for (auto& m : targets)
+		m.clear();
+
+	nodePins.clear();
+
+	for (auto p : pins)
+	{
+		nodePins[paths.getHandle(p->getNodeTree()[PropertyIds::ID], var())].add(p);
+
+		if (!p->canBeTarget())
+			continue;
+
+		auto key = paths.getHandle(p->getNodeTree()[PropertyIds::ID], p->getTargetParameterId());
+
+		for (int i = 0; i < (int)Helpers::ConnectionType::numConnectionTypes; i++)
+		{
+			if (p->matchesConnectionType((Helpers::ConnectionType)i))
+				targets[i][key].add(p);
+		}
+	}
+
+	dirty = false;
+}
+
+NetworkIndex::IdRegistry::ScopedBatch::ScopedBatch(const ValueTree& networkTree)
+{
+	if (auto ni = NetworkIndex::getFor(networkTree))
+	{
+		registry = &ni->ids;
+		previousBatch = registry->currentBatch;
+		registry->currentBatch = this;
+	}
+}
+
+NetworkIndex::IdRegistry::ScopedBatch::~ScopedBatch()
+{
+	if (registry != nullptr)
+	{
+		jassert(registry->currentBatch == this);
+		registry->currentBatch = previousBatch;
+
+		// the nodes will be counted by the listener as soon as they are added to the network
+		for (const auto& id : reservedIds)
+			registry->removeId(id);
+	}
+}
+
+NetworkIndex::IdRegistry::IdRegistry(const ValueTree& networkTree) :
+	root(networkTree)
+{
+	add(root);
+}
+
+juce::String NetworkIndex::IdRegistry::getUniqueId(const String& prefix)
+{
+	auto newId = prefix;
+
+	if (isUsed(newId))
+	{
+		auto base = splitId(prefix).first;
+		auto& suffix = firstFreeSuffix[base];
+
+		// all suffixes below this number are used
+		suffix = jmax(2, suffix);
+
+		while (isUsed(base + String(suffix)))
+			suffix++;
+
+		newId = base + String(suffix);
+	}
+
+	if (currentBatch != nullptr)
+	{
+		addId(newId);
+		currentBatch->reservedIds.add(newId);
+	}
+
+	return newId;
+}
+
+void NetworkIndex::IdRegistry::add(const ValueTree& v)
+{
+	if (v.getType() == PropertyIds::Node)
+	{
+		auto id = v[PropertyIds::ID].toString();
+		nodeIds[getKey(v)] = id;
+		addId(id);
+	}
+
+	for (auto c : v)
+		add(c);
+}
+
+void NetworkIndex::IdRegistry::remove(const ValueTree& v)
+{
+	if (v.getType() == PropertyIds::Node)
+	{
+		removeId(v[PropertyIds::ID].toString());
+		nodeIds.erase(getKey(v));
+	}
+
+	for (auto c : v)
+		remove(c);
+}
+
+void NetworkIndex::IdRegistry::removeId(const String& id)
+{
+	auto it = numUsed.find(id);
+
+	if (it != numUsed.end() && --it->second <= 0)
+	{
+		numUsed.erase(it);
+		release(id);
+	}
+}
+
+void NetworkIndex::IdRegistry::onPropertyChange(const ValueTree& v, const Identifier& id)
+{
+	if (id != PropertyIds::ID || v.getType() != PropertyIds::Node)
+		return;
+
+	auto it = nodeIds.find(getKey(v));
+
+	if (it == nodeIds.end())
+		return;
+
+	auto newId = v[PropertyIds::ID].toString();
+
+	if (it->second != newId)
+	{
+		removeId(it->second);
+		addId(newId);
+		it->second = newId;
+	}
+}
+
+std::pair<juce::String, int> NetworkIndex::IdRegistry::splitId(const String& id)
+{
+	auto base = id.trimCharactersAtEnd("0123456789");
+
+	if (base.isEmpty())
+		return { id, 0 };
+
+	return { base, id.substring(base.length()).getIntValue() };
+}
+
+void NetworkIndex::IdRegistry::release(const String& id)
+{
+	auto s = splitId(id);
+	auto it = firstFreeSuffix.find(s.first);
+
+	if (it != firstFreeSuffix.end() && s.second < it->second)
+		it->second = s.second;
+}
+
+NetworkIndex::DependencyIndex::DependencyIndex(const ValueTree& networkTree) :
+	root(networkTree)
+{
+	add(root, true);
+}
+
+Array<juce::ValueTree> NetworkIndex::DependencyIndex::getNodes(const String& nodeId)
+{
+	return getValidEntries(nodes, nodeId, [&nodeId](const ValueTree& n)
+	{
+		return n[PropertyIds::ID].toString() == nodeId;
+	});
+}
+
+Array<juce::ValueTree> NetworkIndex::DependencyIndex::getConnectionsTo(const String& nodeId)
+{
+	return getValidEntries(connections, nodeId, [&nodeId](const ValueTree& c)
+	{
+		return c[PropertyIds::NodeId].toString() == nodeId;
+	});
+}
+
+Array<juce::ValueTree> NetworkIndex::DependencyIndex::getGroupsWith(const String& nodeId)
+{
+	return getValidEntries(groups, nodeId, [&nodeId](const ValueTree& g)
+	{
+		return getGroupMembers(g).contains(nodeId);
+	});
+}
+
+void NetworkIndex::DependencyIndex::add(const ValueTree& v, bool recursive)
+{
+	auto t = v.getType();
+
+	if (t == PropertyIds::Node)
+		nodes[v[PropertyIds::ID].toString()].addIfNotAlreadyThere(v);
+	else if (t == PropertyIds::Connection)
+		connections[v[PropertyIds::NodeId].toString()].addIfNotAlreadyThere(v);
+	else if (t == UIPropertyIds::Group)
+	{
+		for (const auto& m : getGroupMembers(v))
+			groups[m].addIfNotAlreadyThere(v);
+	}
+
+	if (recursive)
+	{
+		for (auto c : v)
+			add(c, true);
+	}
+}
+
+void NetworkIndex::DependencyIndex::remove(const ValueTree& v)
+{
+	auto t = v.getType();
+
+	if (t == PropertyIds::Node)
+		removeFromBucket(nodes, v[PropertyIds::ID].toString(), v);
+	else if (t == PropertyIds::Connection)
+		removeFromBucket(connections, v[PropertyIds::NodeId].toString(), v);
+	else if (t == UIPropertyIds::Group)
+	{
+		for (const auto& m : getGroupMembers(v))
+			removeFromBucket(groups, m, v);
+	}
+
+	for (auto c : v)
+		remove(c);
+}
+
+void NetworkIndex::DependencyIndex::onPropertyChange(const ValueTree& v, const Identifier& id)
+{
+	auto t = v.getType();
+
+	if ((t == PropertyIds::Node && id == PropertyIds::ID) ||
+		(t == PropertyIds::Connection && id == PropertyIds::NodeId) ||
+		(t == UIPropertyIds::Group && id == PropertyIds::Value))
+	{
+		add(v, false);
+	}
+}
+
+juce::StringArray NetworkIndex::DependencyIndex::getGroupMembers(const ValueTree& g)
+{
+	return StringArray::fromTokens(g[PropertyIds::Value].toString(), ";", "");
+}
+
+void NetworkIndex::DependencyIndex::removeFromBucket(Map& m, const String& key, const ValueTree& v)
+{
+	auto it = m.find(key);
+
+	if (it != m.end())
+	{
+		it->second.removeAllInstancesOf(v);
+
+		if (it->second.isEmpty())
+			m.erase(it);
+	}
+}
+
+Array<juce::ValueTree> NetworkIndex::DependencyIndex::getValidEntries(Map& m, const String& key, const std::function<bool(const ValueTree&)>& isValid)
+{
+	Array<ValueTree> list;
+
+	auto it = m.find(key);
+
+	if (it == m.end())
+		return list;
+
+	auto& bucket = it->second;
+
+	for (int i = 0; i < bucket.size(); i++)
+	{
+		auto v = bucket.getReference(i);
+
+		if (v.isAChildOf(root) && isValid(v))
+			list.add(v);
+		else
+			bucket.remove(i--);
+	}
+
+	if (bucket.isEmpty())
+		m.erase(it);
+
+	return list;
+}
+
+juce::Rectangle<int> NetworkIndex::BoundsCache::getBoundsInRoot(const ValueTree& v, bool includingComment)
+{
+	return Helpers::getBounds(v, includingComment).withPosition(getPositionInRoot(v));
+}
+
+juce::Point<int> NetworkIndex::BoundsCache::getPositionInRoot(const ValueTree& v)
+{
+	jassert(v.getType() == PropertyIds::Node);
+
+	if (Helpers::isRootNode(v))
+		return {};
+
+	auto id = v[PropertyIds::ID].toString();
+	auto it = positions.find(id);
+
+	if (it != positions.end() && it->second.node == v)
+		return it->second.position;
+
+	auto pos = Helpers::getPosition(v);
+	auto parent = Helpers::findParentNode(v);
+
+	if (parent.isValid())
+		pos += getPositionInRoot(parent);
+
+	positions[id] = { v, pos };
+	return pos;
+}
+
+void NetworkIndex::BoundsCache::invalidate(const ValueTree& v)
+{
+	if (positions.empty())
+		return;
+
+	if (v.getType() == PropertyIds::Node)
+	{
+		auto it = positions.find(v[PropertyIds::ID].toString());
+
+		if (it != positions.end() && it->second.node == v)
+			positions.erase(it);
+	}
+
+	for (auto c : v)
+	{
+		if (c.getType() == PropertyIds::Node || c.getType() == PropertyIds::Nodes)
+			invalidate(c);
+	}
+}
+
+void NetworkIndex::BoundsCache::onPropertyChange(const ValueTree& v, const Identifier& id)
+{
+	if (v.getType() == PropertyIds::Node && (id == UIPropertyIds::x || id == UIPropertyIds::y || id == UIPropertyIds::CurrentRoot))
+		invalidate(v);
+}
+
+bool NetworkIndex::FoldCache::isFolded(const ValueTree& v)
+{
+	if (!v.isValid())
+		return false;
+
+	if (v.getType() != PropertyIds::Node)
+		return isFolded(Helpers::findParentNode(v));
+
+	if (Helpers::isRootNode(v))
+		return false;
+
+	auto id = v[PropertyIds::ID].toString();
+	auto it = entries.find(id);
+
+	if (it != entries.end() && it->second.version == version && it->second.node == v)
+		return it->second.folded;
+
+	auto folded = (bool)v[PropertyIds::Folded] || isFolded(Helpers::findParentNode(v));
+
+	entries[id] = { v, version, folded };
+	return folded;
+}
+
+void NetworkIndex::FoldCache::onPropertyChange(const ValueTree& v, const Identifier& id)
+{
+	if (v.getType() == PropertyIds::Node && (id == PropertyIds::Folded || id == UIPropertyIds::CurrentRoot || id == PropertyIds::ID))
+		invalidate();
+}
+
+void NetworkIndex::ValueHub::Subscription::reset()
+{
+	if (auto h = hub.get())
+		h->unsubscribe(slot);
+
+	hub = nullptr;
+	slot = -1;
+}
+
+double NetworkIndex::ValueHub::subscribe(Subscription& s, const ValueTree& parameterTree, Listener* l, PooledUIUpdater* updater)
+{
+	jassert(parameterTree.getType() == PropertyIds::Parameter);
+
+	s.reset();
+
+	int slot;
+
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		slot = (int)listeners.size();
+
+		parameters.emplace_back();
+		sources.emplace_back();
+		values.push_back(0.0);
+		lastValues.push_back(0.0);
+		changed.push_back(0);
+		listeners.push_back(nullptr);
+	}
+
+	auto source = getValueSource(parameterTree);
+	auto v = (double)source[PropertyIds::Value];
+
+	parameters[slot] = parameterTree;
+	sources[slot] = source;
+	values[slot] = v;
+	lastValues[slot] = v;
+	listeners[slot] = l;
+
+	s.hub = this;
+	s.slot = slot;
+
+	if (sampler == nullptr && updater != nullptr)
+		sampler = new Sampler(*this, updater);
+
+	if (numActive++ == 0 && sampler != nullptr)
+		sampler->start();
+
+	return v;
+}
+
+void NetworkIndex::ValueHub::onPropertyChange(const ValueTree& v, const Identifier& id)
+{
+	if (id == PropertyIds::Automated || id == PropertyIds::ID || id == PropertyIds::NodeId || id == PropertyIds::ParameterId)
+		invalidateSources();
+}
+
+ValueTree NetworkIndex::ValueHub::getValueSource(ValueTree p)
+{
+	// same as ParameterHelpers::getThisValueOrFindDirectSource()
+	while (p[PropertyIds::Automated])
+	{
+		auto con = ParameterHelpers::getConnection(p);
+		p = ParameterHelpers::findConnectionParent(con);
+	}
+
+	return p;
+}
+
+void NetworkIndex::ValueHub::unsubscribe(int slot)
+{
+	jassert(isPositiveAndBelow(slot, (int)listeners.size()) && listeners[slot] != nullptr);
+
+	listeners[slot] = nullptr;
+	parameters[slot] = {};
+	sources[slot] = {};
+	freeSlots.push_back(slot);
+
+	// don't delete the sampler here, this might be called from within its callback
+	if (--numActive == 0 && sampler != nullptr)
+		sampler->stop();
+}
+
+void NetworkIndex::ValueHub::sample()
+{
+	auto numSlots = listeners.size();
+
+	if (sourcesDirty)
+	{
+		for (size_t i = 0; i < numSlots; i++)
+		{
+			if (listeners[i] != nullptr)
+				sources[i] = getValueSource(parameters[i]);
+		}
+
+		sourcesDirty = false;
+	}
+
+	auto v = values.data();
+	auto lv = lastValues.data();
+	auto c = changed.data();
+
+	for (size_t i = 0; i < numSlots; i++)
+		v[i] = listeners[i] != nullptr ? (double)sources[i][PropertyIds::Value] : lv[i];
+
+	// a branchless pass over the contiguous arrays that the compiler can vectorise
+	for (size_t i = 0; i < numSlots; i++)
+		c[i] = (uint8)(v[i] != lv[i]);
+
+	for (size_t i = 0; i < numSlots; i++)
+	{
+		if (changed[i] != 0)
+		{
+			lastValues[i] = values[i];
+
+			// the listener might have been removed by a previous callback
+			if (auto l = listeners[i])
+				l->onParameterValue(values[i]);
+		}
+	}
+}
+
+}
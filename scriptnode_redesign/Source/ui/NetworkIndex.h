@@ -0,0 +1,415 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#pragma once
+
+/** Set this to 1 in order to compare every lookup of the NetworkIndex against a full walk of the network tree. */
+#ifndef SCRIPTNODE_CHECK_NETWORK_INDEX
+#define SCRIPTNODE_CHECK_NETWORK_INDEX 0
+#endif
+
+namespace scriptnode {
+using namespace hise;
+using namespace juce;
+
+struct CablePinBase;
+
+/** A lookup cache for a network tree that replaces the full tree walks in the static helper functions.
+
+	It is shared between all DspNetworkComponents that display the same network and kept in sync
+	with a (synchronous) listener to the network tree. The helper functions obtain it with getFor()
+	and fall back to walking the tree if there is no index for the network.
+*/
+struct NetworkIndex : public ReferenceCountedObject,
+					  public ValueTree::Listener
+{
+	using Ptr = ReferenceCountedObjectPtr<NetworkIndex>;
+
+	/** Returns the index for the given network tree and creates one if it doesn't exist yet. */
+	static Ptr getOrCreate(const ValueTree& networkTree);
+
+	/** Returns the index of the network that contains the given tree or nullptr. */
+	static NetworkIndex* getFor(const ValueTree& v);
+
+	~NetworkIndex() override;
+
+	/** Interns the parameter paths (node ID + parameter ID) of the network into integer handles
+		so that they can be compared and used as lookup key without building the path string.
+
+		The handles are never released, so a handle stays valid for the lifetime of the network.
+	*/
+	struct PathTable
+	{
+		using Handle = int;
+		static constexpr Handle InvalidHandle = -1;
+
+		/** Returns the handle for the parameter path of the given Parameter, Connection or Node tree. */
+		Handle getHandle(const ValueTree& v);
+
+		/** Returns the handle for the given node and parameter ID. */
+		Handle getHandle(const var& nodeId, const var& parameterId);
+
+		/** Returns the path string for the given handle. */
+		String getPath(Handle h) const;
+
+	private:
+
+		using Key = std::pair<const void*, const void*>;
+
+		struct KeyHash
+		{
+			size_t operator()(const Key& k) const { return std::hash<const void*>()(k.first) * 31 + std::hash<const void*>()(k.second); }
+		};
+
+		static Identifier toId(const var& v);
+
+		std::unordered_map<Key, Handle, KeyHash> handles;
+		std::vector<std::pair<Identifier, Identifier>> paths;
+	};
+
+	/** Maps parameter paths to the Connection, Parameter and Node trees.
+
+		The trees are added when they are inserted into the network or when one of the properties
+		that make up their path changes. Entries of removed trees or outdated paths are dropped lazily
+		when the path is queried the next time.
+	*/
+	struct ConnectionIndex
+	{
+		ConnectionIndex(const ValueTree& networkTree, PathTable& paths);
+
+		/** Returns the connection for the given parameter / node or the target for the given connection. */
+		ValueTree getConnection(const ValueTree& p);
+
+		void add(const ValueTree& v, bool recursive);
+		void remove(const ValueTree& v, ValueTree parentNode);
+		void onPropertyChange(const ValueTree& v, const Identifier& id);
+
+	private:
+
+		using Map = std::unordered_map<PathTable::Handle, Array<ValueTree>>;
+
+		PathTable::Handle getIndexPath(const ValueTree& v);
+		Map* getMap(const Identifier& type);
+		ValueTree getFirstMatch(Map& m, PathTable::Handle path);
+
+		ValueTree root;
+		PathTable& paths;
+
+		Map connections;
+		Map parameters;
+		Map nodes;
+	};
+
+	/** Maps the (NodeId, ParameterId, ConnectionType) key to all live pins that can be a connection target.
+
+		The pins register themselves in their constructor. The lookup table is rebuilt lazily after
+		a pin was added or removed, after a node or parameter was renamed or after the factory path
+		of a node changed (which decides whether a routable signal pin can be a target).
+	*/
+	struct PinRegistry
+	{
+		PinRegistry(PathTable& paths_) : paths(paths_) {}
+
+		void registerPin(CablePinBase* p);
+		void unregisterPin(CablePinBase* p);
+
+		void markDirty() { dirty = true; }
+
+		/** Returns all target pins for the given connection that accept the connection type. */
+		const Array<CablePinBase*>& getTargets(const ValueTree& con, Helpers::ConnectionType ct);
+
+		/** Returns all pins of the given node. This is used to find the source pin of a new connection. */
+		const Array<CablePinBase*>& getPinsForNode(const ValueTree& nodeTree);
+
+	private:
+
+		void rebuild();
+
+		PathTable& paths;
+		Array<CablePinBase*> pins;
+		std::unordered_map<PathTable::Handle, Array<CablePinBase*>> targets[(int)Helpers::ConnectionType::numConnectionTypes];
+		std::unordered_map<PathTable::Handle, Array<CablePinBase*>> nodePins;
+		Array<CablePinBase*> noTargets;
+		bool dirty = true;
+	};
+
+	/** Keeps track of all node IDs in the network so that unique IDs can be created without walking the tree.
+
+		The IDs are split into a prefix and a numeric suffix and the registry hands out the lowest free
+		suffix (starting with 2) for the given prefix, so the result only depends on the current tree state.
+	*/
+	struct IdRegistry
+	{
+		/** Reserves all IDs that are created during its lifetime for nodes that are not yet added
+			to the network (eg. when pasting or duplicating a selection).
+		*/
+		struct ScopedBatch
+		{
+			ScopedBatch(const ValueTree& networkTree);
+			~ScopedBatch();
+
+		private:
+
+			friend struct IdRegistry;
+
+			IdRegistry* registry = nullptr;
+			ScopedBatch* previousBatch = nullptr;
+			StringArray reservedIds;
+		};
+
+		IdRegistry(const ValueTree& networkTree);
+
+		/** Returns the prefix if it's not used or the prefix with the lowest free number suffix. */
+		String getUniqueId(const String& prefix);
+
+		void add(const ValueTree& v);
+		void remove(const ValueTree& v);
+		void onPropertyChange(const ValueTree& v, const Identifier& id);
+
+	private:
+
+		static std::pair<String, int> splitId(const String& id);
+
+		bool isUsed(const String& id) const { return numUsed.find(id) != numUsed.end(); }
+		void addId(const String& id) { numUsed[id]++; }
+		void removeId(const String& id);
+		void release(const String& id);
+
+		/** The property set lives in the shared object of the tree, so its address identifies the node. */
+		static const void* getKey(const ValueTree& v) { return &v.getProperties(); }
+
+		ValueTree root;
+
+		std::unordered_map<String, int> numUsed;
+		std::unordered_map<const void*, String> nodeIds;
+		std::unordered_map<String, int> firstFreeSuffix;
+		ScopedBatch* currentBatch = nullptr;
+	};
+
+	/** Maps node IDs to the trees that reference them (connections and groups) so that moving or
+		deleting a node only has to visit the affected entries.
+
+		Like the ConnectionIndex, outdated entries are removed when the ID is queried the next time.
+	*/
+	struct DependencyIndex
+	{
+		DependencyIndex(const ValueTree& networkTree);
+
+		/** Returns all nodes with the given ID. */
+		Array<ValueTree> getNodes(const String& nodeId);
+
+		/** Returns all connections that target a parameter (or the node itself) of the given node. */
+		Array<ValueTree> getConnectionsTo(const String& nodeId);
+
+		/** Returns all groups that contain the given node ID. */
+		Array<ValueTree> getGroupsWith(const String& nodeId);
+
+		void add(const ValueTree& v, bool recursive);
+		void remove(const ValueTree& v);
+		void onPropertyChange(const ValueTree& v, const Identifier& id);
+
+	private:
+
+		using Map = std::unordered_map<String, Array<ValueTree>>;
+
+		static StringArray getGroupMembers(const ValueTree& g);
+		static void removeFromBucket(Map& m, const String& key, const ValueTree& v);
+
+		Array<ValueTree> getValidEntries(Map& m, const String& key, const std::function<bool(const ValueTree&)>& isValid);
+
+		ValueTree root;
+
+		Map nodes;
+		Map connections;
+		Map groups;
+	};
+
+	/** Caches the position of every node in the coordinate system of the current root.
+
+		The position of a node is calculated from the cached position of its parent node and the cache
+		entries of a subtree are invalidated when the x / y position (or the CurrentRoot flag) of its
+		root node changes. The size is not cached as it doesn't require a walk up the tree.
+	*/
+	struct BoundsCache
+	{
+		/** Returns the same rectangle as Helpers::getBoundsInRoot(). */
+		Rectangle<int> getBoundsInRoot(const ValueTree& v, bool includingComment);
+
+		/** Returns the top left position of the node relative to the current root node. */
+		Point<int> getPositionInRoot(const ValueTree& v);
+
+		void invalidate(const ValueTree& v);
+		void onPropertyChange(const ValueTree& v, const Identifier& id);
+
+	private:
+
+		struct Entry
+		{
+			ValueTree node;
+			Point<int> position;
+		};
+
+		std::unordered_map<String, Entry> positions;
+	};
+
+	/** Caches the effective folded state of every node (whether the node or one of its parents up to
+		the current root is folded).
+
+		Instead of clearing the entries, every change of a Folded, CurrentRoot or ID property (or a node
+		that is added or removed) bumps the version number so that the outdated entries are recalculated
+		the next time they are queried. This keeps folding a large container at O(1) and the queries in
+		between two changes at O(1) too.
+	*/
+	struct FoldCache
+	{
+		/** Returns the same value as Helpers::isFoldedRecursive(). */
+		bool isFolded(const ValueTree& v);
+
+		void invalidate() { ++version; }
+		void onPropertyChange(const ValueTree& v, const Identifier& id);
+
+	private:
+
+		struct Entry
+		{
+			ValueTree node;
+			uint32 version;
+			bool folded;
+		};
+
+		std::unordered_map<String, Entry> entries;
+		uint32 version = 0;
+	};
+
+	/** Samples the values of all watched parameters once per UI frame and notifies the subscribers
+		whose value has changed.
+
+		Every subscription owns a slot in a set of contiguous arrays, so the change detection is a single
+		pass over two arrays of doubles instead of a timer per component that walks up the component tree
+		to find the parameter source. The tree that holds the value (the parameter itself or the source of
+		its automation) is resolved once and updated when the connections of the network change.
+	*/
+	struct ValueHub
+	{
+		struct Listener
+		{
+			virtual ~Listener() = default;
+
+			/** Called on the message thread when the value of the watched parameter has changed. */
+			virtual void onParameterValue(double newValue) = 0;
+		};
+
+		/** Releases the slot of the subscription when it goes out of scope. */
+		struct Subscription
+		{
+			Subscription() = default;
+			~Subscription() { reset(); }
+
+			void reset();
+			bool isActive() const { return hub.get() != nullptr && slot != -1; }
+
+		private:
+
+			friend struct ValueHub;
+
+			WeakReference<ValueHub> hub;
+			int slot = -1;
+
+			JUCE_DECLARE_NON_COPYABLE(Subscription);
+		};
+
+		/** Subscribes the listener to the value of the parameter tree and returns the current value. */
+		double subscribe(Subscription& s, const ValueTree& parameterTree, Listener* l, PooledUIUpdater* updater);
+
+		void invalidateSources() { sourcesDirty = true; }
+		void onPropertyChange(const ValueTree& v, const Identifier& id);
+
+	private:
+
+		struct Sampler : public PooledUIUpdater::SimpleTimer
+		{
+			Sampler(ValueHub& hub_, PooledUIUpdater* updater) :
+			  SimpleTimer(updater, false),
+			  hub(hub_)
+			{}
+
+			void timerCallback() override { hub.sample(); }
+
+			ValueHub& hub;
+		};
+
+		static ValueTree getValueSource(ValueTree p);
+
+		void unsubscribe(int slot);
+		void sample();
+
+		std::vector<ValueTree> parameters;
+		std::vector<ValueTree> sources;
+		std::vector<double> values;
+		std::vector<double> lastValues;
+		std::vector<uint8> changed;
+		std::vector<Listener*> listeners;
+		std::vector<int> freeSlots;
+
+		int numActive = 0;
+		bool sourcesDirty = false;
+
+		ScopedPointer<Sampler> sampler;
+
+		JUCE_DECLARE_WEAK_REFERENCEABLE(ValueHub);
+	};
+
+	ValueTree networkTree;
+	PathTable paths;
+	ConnectionIndex connections;
+	PinRegistry pins;
+	IdRegistry ids;
+	DependencyIndex dependencies;
+	BoundsCache bounds;
+	FoldCache folds;
+	ValueHub values;
+
+private:
+
+	NetworkIndex(const ValueTree& networkTree);
+
+	static Array<NetworkIndex*>& getRegistry();
+
+	void valueTreePropertyChanged(ValueTree& v, const Identifier& id) override;
+	void valueTreeChildAdded(ValueTree& parent, ValueTree& child) override;
+	void valueTreeChildRemoved(ValueTree& parent, ValueTree& child, int) override;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NetworkIndex);
+};
+
+}
@@ -170,7 +170,11 @@ void NodeComponent::HeaderComponent::mouseDrag(const MouseEvent& e)
 
 			auto rootPos = rootContainer->getLocalPoint(this, downPos);
 
-			root->currentlyHoveredContainer = rootContainer->getInnerContainer(root, rootPos, &parent);
+			// the dragged nodes are already removed from their containers so the layout stays the same until the drop
+			if (root->hoverIndex == nullptr)
+				root->hoverIndex = new ContainerComponent::InnerContainerIndex(root, rootContainer);
+
+			root->currentlyHoveredContainer = root->hoverIndex->getInnerContainer(rootPos, &parent);
 
 			if (parent.hasSignal && root->currentlyHoveredContainer != nullptr)
 			{
@@ -467,4 +471,90 @@ void NodeComponent::onFold(const Identifier& id, const var& newValue)
 	}
 }
 
+LODSnapshot::LODSnapshot(Component& owner_, const ValueTree& v, bool ignoreChildRepaints_) :
+	owner(owner_),
+	ignoreChildRepaints(ignoreChildRepaints_)
+{
+	if (ignoreChildRepaints)
+	{
+		appearanceListener.setCallback(v,
+			{ PropertyIds::ID, PropertyIds::Name, PropertyIds::NodeColour, PropertyIds::Folded, PropertyIds::Bypassed,
+			  PropertyIds::Locked, PropertyIds::Value, PropertyIds::Automated, PropertyIds::Comment },
+			Helpers::UIMode,
+			VT_BIND_RECURSIVE_PROPERTY_LISTENER(onAppearanceChange));
+	}
+}
+
+void LODSnapshot::paint(Graphics& g)
+{
+	auto lod = LODManager::getLOD(owner);
+
+	if (lod != lastLod && contentChanged)
+	{
+		// the swallowed repaints might have changed the content of the other LOD images
+		for (auto& s : snapshots)
+			s.second.dirty = true;
+
+		contentChanged = false;
+	}
+
+	lastLod = lod;
+
+	auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+	auto w = roundToInt((float)owner.getWidth() * scale);
+	auto h = roundToInt((float)owner.getHeight() * scale);
+
+	if (lod == 0 || w <= 0 || h <= 0 || w * h > MaxNumPixels)
+	{
+		owner.paintEntireComponent(g, true);
+		return;
+	}
+
+	auto& s = snapshots[lod];
+
+	auto sizeChanged = s.img.getWidth() != w || s.img.getHeight() != h;
+	auto scaleChanged = std::abs(s.scale - scale) > 0.25f * scale;
+
+	if (s.dirty || sizeChanged || scaleChanged)
+	{
+		if (sizeChanged || !s.img.isValid())
+			s.img = Image(owner.isOpaque() ? Image::RGB : Image::ARGB, w, h, true);
+		else if (!owner.isOpaque())
+			s.img.clear(s.img.getBounds());
+
+		Graphics ig(s.img);
+		ig.addTransform(AffineTransform::scale((float)w / (float)owner.getWidth(), (float)h / (float)owner.getHeight()));
+		owner.paintEntireComponent(ig, true);
+
+		s.scale = scale;
+		s.dirty = false;
+	}
+
+	g.drawImageTransformed(s.img, AffineTransform::scale((float)owner.getWidth() / (float)w, (float)owner.getHeight() / (float)h));
+}
+
+void LODSnapshot::forceInvalidate()
+{
+	for (auto& s : snapshots)
+		s.second.dirty = true;
+
+	forceRepaint = true;
+	owner.repaint();
+	forceRepaint = false;
+}
+
+bool LODSnapshot::handleInvalidation()
+{
+	if (ignoreChildRepaints && lastLod > 0 && !forceRepaint)
+	{
+		contentChanged = true;
+		return false;
+	}
+
+	for (auto& s : snapshots)
+		s.second.dirty = true;
+
+	return true;
+}
+
 }
\ No newline at end of file
@@ -32,6 +32,22 @@
 
 #pragma once
 
+/** Set this to 1 in order to render the nodes and containers into a cached image when the view is zoomed out
+	(LOD 1 and above). The image is reused until a property that affects the appearance changes.
+*/
+#ifndef SCRIPTNODE_LOD_SNAPSHOTS
+#define SCRIPTNODE_LOD_SNAPSHOTS 0
+#endif
+
+/** Set this to 1 in order to create the extra body and the parameter sliders of a process node only when the
+	node is close to the visible area of the DspNetworkComponent. Nodes with a stored size start with a placeholder
+	for their body and plain parameter pins and the DspNetworkComponent creates and releases the content as the
+	user pans around.
+*/
+#ifndef SCRIPTNODE_VIRTUAL_BODIES
+#define SCRIPTNODE_VIRTUAL_BODIES 0
+#endif
+
 
 namespace scriptnode {
 using namespace hise;
@@ -118,6 +134,8 @@ struct SelectableComponent: public ChangeListener,
 
 				auto le = e.getEventRelativeTo(dynamic_cast<Component*>(l));
 
+				l->lassoStateChanged(state);
+
 				if(state == LassoState::Down)
 					l->lasso.beginLasso(le, l);
 				if(state == LassoState::Drag)
@@ -131,6 +149,9 @@ struct SelectableComponent: public ChangeListener,
 			return false;
 		}
 
+		/** Override this if you need to prepare or clean up something for the lasso gesture. */
+		virtual void lassoStateChanged(LassoState state) {}
+
 		void setSelection(const Array<ValueTree>& nodes)
 		{
 			std::vector<SelectableComponent*> matches;
@@ -281,9 +302,11 @@ struct SelectableComponent: public ChangeListener,
 				}
 			}
 
+			auto ni = NetworkIndex::getFor(currentNodes.getFirst());
+
 			for(const auto& n: nextNodes)
 			{
-				bounds.addWithoutMerging(Helpers::getBoundsInRoot(n, false));
+				bounds.addWithoutMerging(ni != nullptr ? ni->bounds.getBoundsInRoot(n, false) : Helpers::getBoundsInRoot(n, false));
 			}
 
 			if(k.getModifiers().isCommandDown() || k.getModifiers().isShiftDown())
@@ -388,6 +411,51 @@ struct SelectableComponent: public ChangeListener,
 	JUCE_DECLARE_WEAK_REFERENCEABLE(SelectableComponent);
 };
 
+/** A cached image that renders the component into one image per LOD level when zoomed out.
+
+	At LOD 0 the component is painted normally. If ignoreChildRepaints is true (which is used for nodes
+	without child nodes), repaints of the component and its children (meters, sliders, displays) are swallowed
+	at the coarse LOD levels and only the listed properties of the node tree will invalidate the image.
+*/
+struct LODSnapshot : public CachedComponentImage
+{
+	static constexpr int MaxNumPixels = 2048 * 2048;
+
+	LODSnapshot(Component& owner_, const ValueTree& v, bool ignoreChildRepaints_);
+
+	void paint(Graphics& g) override;
+
+	bool invalidateAll() override { return handleInvalidation(); }
+	bool invalidate(const Rectangle<int>&) override { return handleInvalidation(); }
+	void releaseResources() override { snapshots.clear(); }
+
+	/** Invalidates the images and repaints the component even if the repaints are currently swallowed. */
+	void forceInvalidate();
+
+private:
+
+	bool handleInvalidation();
+
+	void onAppearanceChange(const ValueTree&, const Identifier&) { forceInvalidate(); }
+
+	struct Snapshot
+	{
+		Image img;
+		float scale = 0.0f;
+		bool dirty = true;
+	};
+
+	Component& owner;
+	const bool ignoreChildRepaints;
+
+	std::map<int, Snapshot> snapshots;
+	int lastLod = 0;
+	bool contentChanged = false;
+	bool forceRepaint = false;
+
+	valuetree::RecursivePropertyListener appearanceListener;
+};
+
 struct NodeComponent : public Component,
 	public SelectableComponent,
 	public PathFactory
@@ -599,7 +667,11 @@ struct NodeComponent : public Component,
 				b.removeFromLeft(bc->getWidth());
 
 			LODManager::LODGraphics lg(g, *this);
-			lg.drawText(Helpers::getHeaderTitle(parent.getValueTree()), b, Justification::left);
+
+			if (lg.getCurrentLOD() == 0)
+				TextLayoutCache::drawText(g, Helpers::getHeaderTitle(parent.getValueTree()), b, Justification::left);
+			else
+				lg.drawText(Helpers::getHeaderTitle(parent.getValueTree()), b, Justification::left);
 		}
 
 		struct BreadcrumbButton: public Component
@@ -829,9 +901,20 @@ struct NodeComponent : public Component,
 
 		setBounds(Helpers::getBounds(v, false));
 
+		contentActive = !canDeferContent(v);
+
 		rebuildDefaultParametersAndOutputs();
 
 		colourListener.setCallback(data, { PropertyIds::NodeColour }, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onColour));
+
+#if SCRIPTNODE_LOD_SNAPSHOTS
+		// the root container covers the entire network so there's no point in caching it
+		if (!Helpers::isRootNode(v))
+		{
+			auto hasChildNodes = Helpers::isContainerNode(v) && !v[PropertyIds::Locked];
+			setCachedComponentImage(new LODSnapshot(*this, v, !hasChildNodes));
+		}
+#endif
 	};
 
 	ScriptnodeExtraComponentBase* createBodyComponent()
@@ -869,6 +952,12 @@ struct NodeComponent : public Component,
 	}
 
 	virtual ~NodeComponent() = default;
+
+	void childrenChanged() override
+	{
+		if (auto s = dynamic_cast<LODSnapshot*>(getCachedComponentImage()))
+			s->forceInvalidate();
+	}
 	
 	void onColour(const Identifier&, const var&)
 	{
@@ -918,7 +1007,7 @@ struct NodeComponent : public Component,
 
 		for (auto p : data.getChildWithName(PropertyIds::Parameters))
 		{
-			addAndMakeVisible(parameters.add(new ParameterComponent(getUpdater(), p, um)));
+			addAndMakeVisible(parameters.add(new ParameterComponent(getUpdater(), p, um, contentActive)));
 		}
 
 		rebuildModulationOutputs();
@@ -1030,7 +1119,7 @@ struct NodeComponent : public Component,
 		else
 			bodyHeight = jmax(extraBounds.getHeight(), parameterHeight);
 
-		x = jmax(x, GLOBAL_FONT().getStringWidth(Helpers::getHeaderTitle(getValueTree())) + 20 + 2 * Helpers::HeaderHeight);
+		x = jmax(x, roundToInt(TextLayoutCache::getStringWidth(GLOBAL_FONT(), Helpers::getHeaderTitle(getValueTree()))) + 20 + 2 * Helpers::HeaderHeight);
 
 		x = jmax(x, extraBounds.getWidth());
 
@@ -1069,8 +1158,27 @@ struct NodeComponent : public Component,
 
 	PooledUIUpdater* getUpdater() { return lasso != nullptr ? lasso->getUpdater() : nullptr; }
 
+	/** Whether a node can start with plain parameter pins and without its extra body. Only process
+		nodes with a stored size qualify because the layout must not depend on the missing content. */
+	static bool canDeferContent(const ValueTree& v)
+	{
+#if SCRIPTNODE_VIRTUAL_BODIES
+		return Helpers::isProcessNode(v) &&
+			   !Helpers::isContainerNode(v) &&
+			   !Helpers::hasRoutableSignal(v) &&
+			   Helpers::hasDefinedBounds(v) &&
+			   !v[PropertyIds::Folded];
+#else
+		ignoreUnused(v);
+		return false;
+#endif
+	}
+
 protected:
 
+	/** false if the parameters are plain pins without their sliders (see SCRIPTNODE_VIRTUAL_BODIES). */
+	bool contentActive = true;
+
 	ValueTree data;
 	UndoManager* um;
 
@@ -1098,7 +1206,9 @@ struct ContainerComponentBase
 	{
 		auto before = outsideParameters.size();
 
-		outsideParameters.clear();
+		// keep the existing components alive so that their cables don't need to be recreated
+		OwnedArray<CablePinBase> existing;
+		existing.swapWith(outsideParameters);
 
 		auto pTrees = ParameterHelpers::getAutomatedChildParameters(asNodeComponent().getValueTree());
 
@@ -1127,11 +1237,27 @@ struct ContainerComponentBase
 			if(found)
 				continue;
 
-			if(auto np = createOutsideParameterComponent(source))
+			CablePinBase* np = nullptr;
+
+			for(int i = 0; i < existing.size(); i++)
 			{
-				outsideParameters.add(np);
-				asNodeComponent().addAndMakeVisible(np);
+				if(existing[i]->data == conParent || existing[i]->data == p)
+				{
+					np = existing.removeAndReturn(i);
+					break;
+				}
 			}
+
+			if(np == nullptr)
+			{
+				np = createOutsideParameterComponent(source);
+
+				if(np != nullptr)
+					asNodeComponent().addAndMakeVisible(np);
+			}
+
+			if(np != nullptr)
+				outsideParameters.add(np);
 		}
 
 		onOutsideParameterChange(before, outsideParameters.size());
@@ -43,7 +43,7 @@ LockedContainerComponent::LockedContainerComponent(Lasso* l, const ValueTree& v,
 	setOpaque(true);
 	for (auto cn : v.getChildWithName(PropertyIds::Nodes))
 	{
-		if (Helpers::getFactoryPath(cn).second == "locked_mod")
+		if (NodeDescriptor::get(cn).hasFlag(NodeDescriptor::LockedMod))
 		{
 			auto mt = cn.getOrCreateChildWithName(PropertyIds::ModulationTargets, um);
 			addAndMakeVisible(modOutputs.add(new ModOutputComponent(mt, um)));
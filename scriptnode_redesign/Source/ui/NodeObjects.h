@@ -32,7 +32,6 @@
 
 #pragma once
 
-
 namespace scriptnode {
 using namespace hise;
 using namespace juce;
@@ -116,7 +115,7 @@ struct ProcessNodeComponent : public NodeComponent
 			return ct == Helpers::ConnectionType::RoutableSignal;
 		};
 
-		bool canBeTarget() const override { return Helpers::getFactoryPath(parent.getValueTree()).second == "receive"; }
+		bool canBeTarget() const override { return NodeDescriptor::get(parent.getValueTree()).hasFlag(NodeDescriptor::Receive); }
 
 		ValueTree getConnectionTree() const override 
 		{
@@ -147,7 +146,12 @@ struct ProcessNodeComponent : public NodeComponent
 
 			g.setFont(GLOBAL_FONT());
 
-			lg.drawText(getSourceDescription().fromFirstOccurrenceOf(".", false, false), getLocalBounds().reduced(10, 0).toFloat(), j);
+			auto text = getSourceDescription().fromFirstOccurrenceOf(".", false, false);
+
+			if (lg.getCurrentLOD() == 0)
+				TextLayoutCache::drawText(g, text, getLocalBounds().reduced(10, 0).toFloat(), j);
+			else
+				lg.drawText(text, getLocalBounds().reduced(10, 0).toFloat(), j);
 		}
 
 		String getSourceDescription() const override
@@ -237,10 +241,25 @@ struct ProcessNodeComponent : public NodeComponent
 
 		setOpaque(true);
 
-		extraBody = createBodyComponent();
+#if SCRIPTNODE_VIRTUAL_BODIES
+		auto hasBody = NodeDescriptor::get(v).getExtraBody() == NodeDescriptor::ExtraBody::Yes;
 
-		if(extraBody == nullptr)
-			extraBody = DummyBody::createDummyComponent(v[PropertyIds::FactoryPath].toString());
+		if (!contentActive && hasBody)
+		{
+			// The stored size already contains the body so we can skip it until the node becomes visible.
+			// The process nodes always place the body above the parameters (see resized()).
+			auto bodyHeight = getHeight() - Helpers::HeaderHeight - Helpers::SignalHeight - getParameterAreaHeight() - 20;
+
+			if (bodyHeight > 0)
+			{
+				deferredBody = { 0, 0, getWidth() - 20, bodyHeight };
+				resized();
+				return;
+			}
+		}
+#endif
+
+		extraBody = createExtraBody();
 
 		if(routableSignal != nullptr)
 		{
@@ -280,6 +299,153 @@ struct ProcessNodeComponent : public NodeComponent
 
 		auto lod = LODManager::getLOD(*this);
 
+		if(!signalGeometry.matches(getLocalBounds(), numChannels, lod))
+			rebuildSignalGeometry(lod);
+
+		for (const auto& c : signalGeometry.channels)
+		{
+			if (!c.shadow.isEmpty())
+			{
+				g.setColour(Colours::black.withAlpha(0.7f));
+				g.fillPath(c.shadow);
+			}
+
+			g.setColour(cl);
+			g.fillPath(c.cable);
+
+			if (isPositiveAndBelow(c.pinIndex, (int)cables.size()))
+			{
+				g.setColour(Colours::grey);
+				g.fillPath(cables[c.pinIndex].first);
+				g.fillPath(cables[c.pinIndex].second);
+			}
+		}
+
+		if (!deferredBody.isEmpty() && !getValueTree()[PropertyIds::Folded])
+		{
+			g.setColour(Colours::black.withAlpha(0.1f));
+			g.fillRoundedRectangle(deferredBody.toFloat(), 3.0f);
+		}
+	}
+
+	Component* createExtraBody()
+	{
+		Component* b = createBodyComponent();
+
+		if (b == nullptr)
+			b = DummyBody::createDummyComponent(getValueTree()[PropertyIds::FactoryPath].toString());
+
+		NodeDescriptor::get(getValueTree()).setHasExtraBody(b != nullptr);
+		return b;
+	}
+
+	int getParameterAreaHeight() const
+	{
+		auto parameterHeight = parameters.size() * (Helpers::ParameterMargin + getParameterHeight());
+		auto modHeight = modOutputs.size() * (Helpers::ModulationOutputHeight + Helpers::ParameterMargin);
+		return jmax(parameterHeight, modHeight);
+	}
+
+	/** Whether the node content (the extra body and the parameter sliders) can be released and
+		created with setContentActive(). */
+	bool hasVirtualContent() const
+	{
+#if SCRIPTNODE_VIRTUAL_BODIES
+		return routableSignal == nullptr && !Helpers::isContainerNode(getValueTree());
+#else
+		return false;
+#endif
+	}
+
+	bool isContentActive() const { return contentActive; }
+
+	Component* getExtraBody() const { return extraBody.get(); }
+
+	/** Creates or releases the extra body and the parameter sliders. This is called by the DspNetworkComponent
+		when the node enters or leaves the visible area in the virtual body mode. The parameters and
+		modulation outputs stay in place as plain pins so that the cables keep their targets. */
+	void setContentActive(bool shouldBeActive)
+	{
+		if (!hasVirtualContent() || shouldBeActive == contentActive)
+			return;
+
+		contentActive = shouldBeActive;
+
+		for (auto p : parameters)
+			p->setControlsActive(shouldBeActive);
+
+		if (shouldBeActive && !deferredBody.isEmpty())
+		{
+			auto placeholder = deferredBody;
+			deferredBody = {};
+
+			extraBody = createExtraBody();
+
+			if (extraBody != nullptr)
+			{
+				// Scrolling must not change the document, so the body takes the size of the
+				// placeholder instead of resizing the node.
+				if (extraBody->getHeight() != placeholder.getHeight())
+					extraBody->setSize(extraBody->getWidth(), placeholder.getHeight());
+
+				addChildComponent(extraBody);
+				extraBody->setVisible(!(bool)getValueTree()[PropertyIds::Folded]);
+			}
+
+			resized();
+		}
+		else if (!shouldBeActive && extraBody != nullptr)
+		{
+			deferredBody = extraBody->getBounds();
+			extraBody = nullptr;
+		}
+
+		repaint();
+	}
+
+	/** The stroked channel curves. They only depend on the bounds, the channel count and the LOD
+	    so they are rebuilt lazily instead of on every paint call. Every curve keeps its own paths
+	    so that it's drawn in the original order (shadow, curve, pin holes). */
+	struct SignalGeometry
+	{
+		struct Channel
+		{
+			Path shadow, cable;
+			int pinIndex = -1;
+		};
+
+		bool matches(Rectangle<int> b, int nc, int l) const
+		{
+			return !dirty && bounds == b && numChannels == nc && lod == l;
+		}
+
+		std::vector<Channel> channels;
+		Rectangle<int> bounds;
+		int numChannels = -1;
+		int lod = -1;
+		bool dirty = true;
+	};
+
+	void rebuildSignalGeometry(int lod)
+	{
+		signalGeometry.channels.clear();
+
+		auto stroke = LayoutTools::getCableThickness(lod);
+
+		auto addStroke = [&](const Path& src, int pinIndex)
+		{
+			signalGeometry.channels.push_back({});
+			auto& c = signalGeometry.channels.back();
+
+			if(lod == 0)
+			{
+				PathStrokeType(3.0f).createStrokedPath(c.shadow, src);
+				c.pinIndex = pinIndex;
+			}
+
+			PathStrokeType(stroke).createStrokedPath(c.cable, src);
+		};
+
 		if(routableSignal != nullptr)
 		{
 			jassert(routableSignal->screws.size() == numChannels);
@@ -306,40 +472,22 @@ struct ProcessNodeComponent : public NodeComponent
 				Path p;
 
 				Helpers::createCustomizableCurve(p, p1, p2, offset, lod == 0 ? 3.0f : 0.0f, true);
-
-				auto stroke = LayoutTools::getCableThickness(lod);
-
-				if(lod == 0)
-				{
-					g.setColour(Colours::black.withAlpha(0.7f));
-					g.strokePath(p, PathStrokeType(3.0f));
-				}
-
-				g.setColour(cl);
-				g.strokePath(p, PathStrokeType(stroke));
+				addStroke(p, -1);
 			}
 		}
 
-		
-
-		for(auto& c: cables)
+		for(int i = 0; i < (int)cables.size(); i++)
 		{
-			if(lod == 0)
-			{
-				g.setColour(Colours::black.withAlpha(0.7f));
-				g.drawLine({ c.first.getBounds().getCentre(), c.second.getBounds().getCentre() }, 3.0f);
-			}
-			
-			g.setColour(cl);
-			g.drawLine({ c.first.getBounds().getCentre(), c.second.getBounds().getCentre() }, LayoutTools::getCableThickness(lod));
-
-			if(lod == 0)
-			{
-				g.setColour(Colours::grey);
-				g.fillPath(c.first);
-				g.fillPath(c.second);
-			}
+			Path l;
+			l.startNewSubPath(cables[i].first.getBounds().getCentre());
+			l.lineTo(cables[i].second.getBounds().getCentre());
+			addStroke(l, i);
 		}
+
+		signalGeometry.bounds = getLocalBounds();
+		signalGeometry.numChannels = numChannels;
+		signalGeometry.lod = lod;
+		signalGeometry.dirty = false;
 	}
 
 	void onFold(const Identifier& id, const var& newValue) override
@@ -374,6 +522,13 @@ struct ProcessNodeComponent : public NodeComponent
 			b.removeFromTop(extraBody->getHeight() + 20);
 			deltaY += extraBody->getHeight() + 20;
 		}
+		else if (!deferredBody.isEmpty() && !getValueTree()[PropertyIds::Folded])
+		{
+			deferredBody.setPosition(b.getTopLeft().translated(10, 10));
+
+			b.removeFromTop(deferredBody.getHeight() + 20);
+			deltaY += deferredBody.getHeight() + 20;
+		}
 
 		for (auto p : parameters)
 			p->setTopLeftPosition(p->getPosition().translated(0, deltaY));
@@ -381,13 +536,20 @@ struct ProcessNodeComponent : public NodeComponent
 		for (auto m : modOutputs)
 			m->setTopLeftPosition(m->getPosition().translated(0, deltaY));
 
-		cables.clear();
-
 		b = getLocalBounds();
 		b.removeFromTop(Helpers::HeaderHeight);
 		auto sb = b.removeFromTop(Helpers::SignalHeight);
 
-		numChannels = Helpers::getNumChannels(getValueTree());
+		auto newNumChannels = Helpers::getNumChannels(getValueTree());
+
+		// the pin paths only depend on the size and the channel count
+		if(newNumChannels == numChannels && (int)cables.size() == numChannels && pinBounds == getLocalBounds())
+			return;
+
+		numChannels = newNumChannels;
+		pinBounds = getLocalBounds();
+		signalGeometry.dirty = true;
+		cables.clear();
 
 		input.numChannels = numChannels;
 		output.numChannels = numChannels;
@@ -416,9 +578,12 @@ struct ProcessNodeComponent : public NodeComponent
 	}
 
 	std::vector<std::pair<Path, Path>> cables;
+	Rectangle<int> pinBounds;
+	SignalGeometry signalGeometry;
 	
 	ScopedPointer<RoutableSignalComponent> routableSignal;
 	ScopedPointer<Component> extraBody;
+	Rectangle<int> deferredBody;
 	int numChannels = 2;
 
 	VuMeter input, output;
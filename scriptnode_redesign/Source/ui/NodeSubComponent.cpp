@@ -130,6 +130,23 @@ scriptnode::CablePinBase::Connections CablePinBase::rebuildConnections(Component
 
 	auto thisType = getConnectionType();
 
+	if (networkIndex != nullptr)
+	{
+		for (auto d : getConnectionTree())
+		{
+			for (auto c : networkIndex->pins.getTargets(d, thisType))
+			{
+				if (!parent->isParentOf(c) || c->findParentComponentOfClass<NodeComponent::PopupComponent>())
+					continue;
+
+				if (std::find(connections.begin(), connections.end(), c) == connections.end())
+					connections.push_back(c);
+			}
+		}
+
+		return connections;
+	}
+
 	Component::callRecursive<CablePinBase>(parent, [&](CablePinBase* c)
 		{
 			if (c->findParentComponentOfClass<NodeComponent::PopupComponent>())
@@ -481,11 +498,11 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 		return RangeHelpers::getDoubleRange(getParent().data);
 
 #if 0
-		auto r = getParent().slider.getRange();
+		auto r = getParent().getSlider().getRange();
 		d.rng.start = r.getStart();
 		d.rng.end = r.getEnd();
-		d.rng.skew = getParent().slider.getSkewFactor();
-		d.rng.interval = getParent().slider.getInterval();
+		d.rng.skew = getParent().getSlider().getSkewFactor();
+		d.rng.interval = getParent().getSlider().getInterval();
 		d.inv = RangeHelpers::isInverted(getParent().data);
 		return d;
 #endif
@@ -517,7 +534,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 		InvertableParameterRange nr;
 		nr.rng.start = newStart;
 		nr.rng.end = newEnd;
-		nr.rng.interval = s.slider.getInterval();
+		nr.rng.interval = s.getSlider().getInterval();
 		nr.rng.skew = skewToUse;
 		nr.inv = oldRange.inv;
 
@@ -531,7 +548,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 
 		auto pRange = getParentRange();
 		auto v = pRange.convertFrom0to1(nv, true);
-		getParent().slider.setValue(v, sendNotification);
+		getParent().getSlider().setValue(v, sendNotification);
 		repaint();
 	}
 
@@ -540,7 +557,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 	{
 		auto r = getParentRange();
 
-		auto v = getParent().slider.getValueFromText(t.getText());
+		auto v = getParent().getSlider().getValueFromText(t.getText());
 
 		r.inv = RangeHelpers::isInverted(getParent().data);
 		auto isLeft = currentTextPos == Left;// && !inv) || (Right && inv);
@@ -548,7 +565,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 		if (currentTextPos == Inside)
 			r.setSkewForCentre(v);
 		else if (currentTextPos == Outside)
-			getParent().slider.setValue(v, sendNotificationAsync);
+			getParent().getSlider().setValue(v, sendNotificationAsync);
 		else if (isLeft)
 			r.rng.start = v;
 		else
@@ -619,7 +636,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 				path.startNewSubPath({ 0.0f, inv ? startValue : 1.0f - startValue });
 			}
 
-			auto modValue = getParent().slider.getValue();
+			auto modValue = getParent().getSlider().getValue();
 
 
 
@@ -712,7 +729,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 				g.setColour(Colours::white.withAlpha(0.1f));
 				g.fillRoundedRectangle(b, b.getHeight() / 2.0f);
 
-				auto nv = getParentRange().convertTo0to1(getParent().slider.getValue(), false);
+				auto nv = getParentRange().convertTo0to1(getParent().getSlider().getValue(), false);
 
 				if (inv)
 					nv = 1.0 - nv;
@@ -738,7 +755,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 		switch (p)
 		{
 		case Left:
-		case Right: return getParent().slider.getTextFromValue(newStart) + " - " + getParent().slider.getTextFromValue(newEnd);
+		case Right: return getParent().getSlider().getTextFromValue(newStart) + " - " + getParent().getSlider().getTextFromValue(newEnd);
 		case Inside: return "Mid: " + String(getParentRange().convertFrom0to1(0.5, false));
 		default: break;
 		}
@@ -768,10 +785,10 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 
 			switch (p)
 			{
-			case Left:   t = getParent().slider.getTextFromValue(getParent().slider.getMinimum()); break;
-			case Right:  t = getParent().slider.getTextFromValue(getParent().slider.getMaximum()); break;
+			case Left:   t = getParent().getSlider().getTextFromValue(getParent().getSlider().getMinimum()); break;
+			case Right:  t = getParent().getSlider().getTextFromValue(getParent().getSlider().getMaximum()); break;
 			case Inside: t = String(getParentRange().convertFrom0to1(0.5, false)); break;
-			case Outside: t = getParent().slider.getTextFromValue(getParent().slider.getValue()); break;
+			case Outside: t = getParent().getSlider().getTextFromValue(getParent().getSlider().getValue()); break;
 			default: break;
 			}
 
@@ -883,7 +900,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 			Component::SafePointer<RangeComponent> rc = this;
 
 			PopupMenu m;
-			m.setLookAndFeel(&getParent().laf);
+			m.setLookAndFeel(&getParent().getControls().laf);
 
 			m.addItem(1, "Make sticky", true, !temporary);
 
@@ -902,7 +919,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 			m.addItem(3, "Save Range Preset");
 			m.addSeparator();
 			m.addItem(4, "Reset Range");
-			m.addItem(6, "Reset skew", getParent().slider.getSkewFactor() != 1.0);
+			m.addItem(6, "Reset skew", getParent().getSlider().getSkewFactor() != 1.0);
 			m.addSeparator();
 			m.addItem(5, "Invert range", true, RangeHelpers::isInverted(getParent().data));
 			m.addItem(7, "Copy range to source", connectionSource.isValid());
@@ -1030,7 +1047,7 @@ struct ParameterComponent::RangeComponent : public ComponentWithMiddleMouseDrag,
 
 		currentRangeAtDragStart = currentRange;
 
-		//currentRangeAtDragStart.rng.skew = getParent().slider.getSkewFactor();
+		//currentRangeAtDragStart.rng.skew = getParent().getSlider().getSkewFactor();
 
 		skewToUse = currentRangeAtDragStart.rng.skew;
 		repaint();
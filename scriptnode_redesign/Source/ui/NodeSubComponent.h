@@ -80,7 +80,11 @@ struct CablePinBase : public Component,
 	using WeakPtr = WeakReference<CablePinBase>;
 	using Connections = std::vector<WeakPtr>;
 
-	virtual ~CablePinBase() = default;
+	virtual ~CablePinBase()
+	{
+		if (networkIndex != nullptr)
+			networkIndex->pins.unregisterPin(this);
+	}
 
     virtual Helpers::ConnectionType getConnectionType() const = 0;
 
@@ -91,8 +95,12 @@ struct CablePinBase : public Component,
 	CablePinBase(const ValueTree& v, UndoManager* um_) :
 		data(v),
 		um(um_),
-		targetIcon(createPath("target"))
-	{};
+		targetIcon(createPath("target")),
+		networkIndex(NetworkIndex::getFor(v))
+	{
+		if (networkIndex != nullptr)
+			networkIndex->pins.registerPin(this);
+	};
 
 	Path createPath(const String& url) const override
 	{
@@ -118,7 +126,12 @@ struct CablePinBase : public Component,
 
     bool isFoldedAway() const
     {
-        return Helpers::isFoldedRecursive(getNodeTree().getParent().getParent());
+        auto parentNode = getNodeTree().getParent().getParent();
+
+        if(networkIndex != nullptr)
+            return networkIndex->folds.isFolded(parentNode);
+
+        return Helpers::isFoldedRecursive(parentNode);
     }
     
     /** Override this method and check if the value tree for the given connection
@@ -188,12 +201,15 @@ protected:
 	Path targetIcon;
 	bool draggingEnabled = false;
 
+	NetworkIndex::Ptr networkIndex;
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(CablePinBase);
 };
 
 struct ParameterComponent : public CablePinBase,
 							public Slider::Listener,
-							public PooledUIUpdater::SimpleTimer
+							public NetworkIndex::ValueHub::Listener,
+							public VisibilityClient
 {
 	struct Laf: public GlobalHiseLookAndFeel
 	{
@@ -290,20 +306,94 @@ struct ParameterComponent : public CablePinBase,
 			}
 			
 		}
-	} laf;
+	};
+
+	/** The slider, the drop down and the listeners that keep them in sync with the parameter.
+		The parameters of virtual nodes start without them and stay plain cable pins until the
+		node enters the visible area (see SCRIPTNODE_VIRTUAL_BODIES). */
+	struct Controls
+	{
+		Controls() :
+			dropDown("")
+		{}
+
+		Laf laf;
+		juce::Slider slider;
+		TextButton dropDown;
+
+		valuetree::PropertyListener rangeUpdater;
+		valuetree::PropertyListener automationUpdater;
+	};
 
 	struct RangeComponent;
 
-	ParameterComponent(PooledUIUpdater* updater, ValueTree v, UndoManager* um_) :
+	ParameterComponent(PooledUIUpdater* updater_, ValueTree v, UndoManager* um_, bool createControls=true) :
 		CablePinBase(v, um_),
-		SimpleTimer(updater, false),
-		dropDown("")
+		updater(updater_)
 	{
 		jassert(v.getType() == PropertyIds::Parameter);
+
+		if (createControls)
+			setControlsActive(true);
+
+		setSize(Helpers::ParameterWidth, Helpers::ParameterHeight);
+
+		auto parentNode = valuetree::Helpers::findParentWithType(v, PropertyIds::Node);
+
+		if(Helpers::isContainerNode(parentNode) && !Helpers::isFoldedOrLockedContainer(parentNode))
+		{
+			NodeDatabase db;
+			
+			auto hasFixed = db.getProperties(parentNode[PropertyIds::FactoryPath])->hasProperty(PropertyIds::HasFixedParameters);
+
+			auto hasPosition = !Helpers::getPosition(v).isOrigin();
+
+			setEnableDragging(!hasFixed && !hasPosition);
+
+			if (!v.hasProperty(PropertyIds::NodeColour))
+			{
+				auto c = ParameterHelpers::getParameterColour(v);
+				v.setProperty(PropertyIds::NodeColour, c.getARGB(), um);
+			}
+		}
+	};
+
+	bool hasControls() const { return controls != nullptr; }
+
+	/** Returns the controls and creates them if the parameter is still a plain pin. */
+	Controls& getControls()
+	{
+		if (controls == nullptr)
+			setControlsActive(true);
+
+		return *controls;
+	}
+
+	juce::Slider& getSlider() { return getControls().slider; }
+
+	/** Creates or releases the slider and the drop down. The pin itself stays registered
+		so the cables don't notice the difference. */
+	void setControlsActive(bool shouldBeActive)
+	{
+		if (shouldBeActive == hasControls())
+			return;
+
+		if (!shouldBeActive)
+		{
+			valueSubscription.reset();
+			controls = nullptr;
+			repaint();
+			return;
+		}
+
+		controls = new Controls();
+
+		auto& slider = controls->slider;
+
 		addAndMakeVisible(slider);
-		slider.setLookAndFeel(&laf);
+		slider.setLookAndFeel(&controls->laf);
 
-		auto nr = scriptnode::RangeHelpers::getDoubleRange(v);
+		auto nr = scriptnode::RangeHelpers::getDoubleRange(data);
 
 		slider.setNormalisableRange(nr.rng);
 		slider.setSliderStyle(Slider::RotaryHorizontalVerticalDrag);
@@ -323,36 +413,16 @@ struct ParameterComponent : public CablePinBase,
 		auto rangeIds = RangeHelpers::getRangeIds();
 		rangeIds.add(PropertyIds::TextToValueConverter);
 
-		rangeUpdater.setCallback(data, rangeIds, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onRange));
+		controls->rangeUpdater.setCallback(data, rangeIds, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onRange));
 		
-		automationUpdater.setCallback(data, { PropertyIds::Automated }, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onAutomated));
+		controls->automationUpdater.setCallback(data, { PropertyIds::Automated }, Helpers::UIMode, VT_BIND_PROPERTY_LISTENER(onAutomated));
 		onAutomated({}, data[PropertyIds::Automated]);
 
-		addChildComponent(dropDown);
-
-		
-
-		setSize(Helpers::ParameterWidth, Helpers::ParameterHeight);
-
-		auto parentNode = valuetree::Helpers::findParentWithType(v, PropertyIds::Node);
-
-		if(Helpers::isContainerNode(parentNode) && !Helpers::isFoldedOrLockedContainer(parentNode))
-		{
-			NodeDatabase db;
-			
-			auto hasFixed = db.getProperties(parentNode[PropertyIds::FactoryPath])->hasProperty(PropertyIds::HasFixedParameters);
-
-			auto hasPosition = !Helpers::getPosition(v).isOrigin();
-
-			setEnableDragging(!hasFixed && !hasPosition);
+		addChildComponent(controls->dropDown);
 
-			if (!v.hasProperty(PropertyIds::NodeColour))
-			{
-				auto c = ParameterHelpers::getParameterColour(v);
-				v.setProperty(PropertyIds::NodeColour, c.getARGB(), um);
-			}
-		}
-	};
+		resized();
+		repaint();
+	}
 
 	void sliderValueChanged(Slider* s) override
 	{
@@ -361,42 +431,57 @@ struct ParameterComponent : public CablePinBase,
 
 	double lastValue = 0;
 
-	void timerCallback() override
+	void onParameterValue(double nv) override
 	{
-		if(auto pc = findParentComponentOfClass<scriptnode::ParameterSourceObject>())
+		if(lastValue != nv)
 		{
-			auto idx = data.getParent().indexOf(data);
-			auto nv = pc->getParameterValue(idx);
+			lastValue = nv;
 
-			if(lastValue != nv)
+			if (controls != nullptr)
 			{
-				lastValue = nv;
-				slider.setValue(lastValue, dontSendNotification);
+				controls->slider.setValue(lastValue, dontSendNotification);
 
-				if(dropDown.isToggleable())
-					dropDown.setToggleState(lastValue > 0.5, dontSendNotification);
-
-				repaint();
+				if(controls->dropDown.isToggleable())
+					controls->dropDown.setToggleState(lastValue > 0.5, dontSendNotification);
 			}
+
+			repaint();
 		}
 	}
 
 	void onAutomated(const Identifier& id, const var& newValue)
 	{
+		jassert(controls != nullptr);
+		auto& slider = controls->slider;
+
 		if((bool)newValue)
 		{
-			start();
 			slider.setEnabled(false);
 			slider.getValueObject().referTo({});
+
+			// the value hub samples the automation source of this parameter
+			if (isActive())
+			{
+				if (auto ni = NetworkIndex::getFor(data))
+					onParameterValue(ni->values.subscribe(valueSubscription, data, this, updater));
+			}
 		}
 		else
 		{
-			stop();
+			valueSubscription.reset();
 			slider.setEnabled(true);
 			slider.getValueObject().referTo(data.getPropertyAsValue(PropertyIds::Value, um, false));
 		}
 	}
 
+	void activeStateChanged() override
+	{
+		if (!isActive())
+			valueSubscription.reset();
+		else if (controls != nullptr && data[PropertyIds::Automated])
+			onAutomated(PropertyIds::Automated, true);
+	}
+
 	bool isOutsideParameter() const;
 
 	void paint(Graphics& g) override
@@ -424,7 +509,7 @@ struct ParameterComponent : public CablePinBase,
 
 		tb.removeFromLeft(Helpers::ParameterMargin);
 
-		if(slider.isVisible())
+		if(controls != nullptr && controls->slider.isVisible())
 			tb.removeFromLeft(Helpers::ParameterHeight);
 		
 		if(isOutsideParameter())
@@ -451,12 +536,12 @@ struct ParameterComponent : public CablePinBase,
 
 			lg.drawText(rootId, nb.reduced(3.0f, 0.0f), Justification::left);
 		}
-		else
+		else if (controls != nullptr)
 		{
 			g.setFont(GLOBAL_FONT());
 			g.setColour(Colours::white.withAlpha(0.6f));
 
-			lg.drawText(slider.getTextFromValue(slider.getValue()), tb.reduced(0.0f, 2.0f), Justification::bottomLeft);
+			lg.drawText(controls->slider.getTextFromValue(controls->slider.getValue()), tb.reduced(0.0f, 2.0f), Justification::bottomLeft);
 		}
 		
 		g.setFont(GLOBAL_BOLD_FONT());
@@ -498,19 +583,27 @@ struct ParameterComponent : public CablePinBase,
 
 	void resized() override
 	{
+		if (controls == nullptr)
+			return;
+
 		auto b = getLocalBounds();
 
-		if(slider.isVisible())
-			slider.setBounds(b.removeFromLeft(Helpers::ParameterHeight));
+		if(controls->slider.isVisible())
+			controls->slider.setBounds(b.removeFromLeft(Helpers::ParameterHeight));
 		else
 		{
 			b.removeFromRight(Helpers::ParameterMargin);
-			dropDown.setBounds(b.removeFromBottom(b.getHeight() / 2));
+			controls->dropDown.setBounds(b.removeFromBottom(b.getHeight() / 2));
 		}
 	}
 
 	void onRange(const Identifier&, const var&)
 	{
+		jassert(controls != nullptr);
+		auto& slider = controls->slider;
+		auto& dropDown = controls->dropDown;
+		auto& laf = controls->laf;
+
 		auto nr = RangeHelpers::getDoubleRange(data);
 		slider.setNormalisableRange(nr.rng);
 
@@ -536,6 +629,7 @@ struct ParameterComponent : public CablePinBase,
 
 				dropDown.onClick = [this, vtc]()
 				{
+					auto& dropDown = controls->dropDown;
 					auto v = 1 - (int)dropDown.getToggleState();
 					data.setProperty(PropertyIds::Value, 1 - v, um);
 					dropDown.setButtonText(vtc.itemList[v]);
@@ -546,7 +640,7 @@ struct ParameterComponent : public CablePinBase,
 				dropDown.onClick = [this, vtc]()
 				{
 					PopupMenu m;
-					m.setLookAndFeel(&laf);
+					m.setLookAndFeel(&controls->laf);
 
 					auto value = (int)this->data[PropertyIds::Value];
 
@@ -567,7 +661,7 @@ struct ParameterComponent : public CablePinBase,
 						m.addItem(1 + i, s, !automated, i == value);
 					}
 
-					auto r = m.showAt(&dropDown);
+					auto r = m.showAt(&controls->dropDown);
 
 					if (r != 0)
 					{
@@ -585,12 +679,10 @@ struct ParameterComponent : public CablePinBase,
 		repaint();
 	}
 
-	juce::Slider slider;
+	ScopedPointer<Controls> controls;
 
-	valuetree::PropertyListener rangeUpdater;
-	valuetree::PropertyListener automationUpdater;
-
-	TextButton dropDown;
+	PooledUIUpdater* updater;
+	NetworkIndex::ValueHub::Subscription valueSubscription;
 };
 
 struct LockedTarget: public CablePinBase
@@ -792,7 +884,7 @@ struct FoldedInput: public ParameterComponent
 	  ParameterComponent(updater, v, um)
 	{
 		setSize(Helpers::ParameterWidth, Helpers::ParameterHeight);
-		slider.setVisible(false);
+		getSlider().setVisible(false);
 	}
 
 	void paint(Graphics& g) override
@@ -885,7 +977,7 @@ struct BuildHelpers
 		
 		auto root = valuetree::Helpers::findParentWithType(newParent, PropertyIds::Network);
 		
-		forEach(root, PropertyIds::Connection, [&](ValueTree& con)
+		auto updateHideCable = [&](ValueTree& con)
 		{
 			auto target = ParameterHelpers::getTarget(con);
 			auto connectionParentNode = Helpers::findParentNode(con);
@@ -899,7 +991,24 @@ struct BuildHelpers
 					break;
 				}
 			}
-		});
+		};
+
+		if(auto ni = NetworkIndex::getFor(root))
+		{
+			// only visit the connections that point to a node within the moved subtrees
+			for(auto& n: nodesToBeMoved)
+			{
+				forEach(n, PropertyIds::Node, [&](ValueTree& cn)
+				{
+					for(auto con: ni->dependencies.getConnectionsTo(cn[PropertyIds::ID].toString()))
+						updateHideCable(con);
+				});
+			}
+		}
+		else
+		{
+			forEach(root, PropertyIds::Connection, updateHideCable);
+		}
 
 		auto removedGroups = removeFromGroups(root, nodeIds, um);
 
@@ -916,7 +1025,7 @@ struct BuildHelpers
 	{
 		Array<ValueTree> groupsToDelete;
 
-		forEach(root, UIPropertyIds::Group, [&](ValueTree& g)
+		auto removeIds = [&](ValueTree& g)
 			{
 				auto idList = StringArray::fromTokens(g[PropertyIds::Value].toString(), ";", "");
 				auto before = idList.size();
@@ -931,7 +1040,25 @@ struct BuildHelpers
 					else
 						g.setProperty(PropertyIds::Value, idList.joinIntoString(";"), um);
 				}
-			});
+			};
+
+		if (auto ni = NetworkIndex::getFor(root))
+		{
+			Array<ValueTree> affectedGroups;
+
+			for (auto& n : nodeIds)
+			{
+				for (auto g : ni->dependencies.getGroupsWith(n))
+					affectedGroups.addIfNotAlreadyThere(g);
+			}
+
+			for (auto& g : affectedGroups)
+				removeIds(g);
+		}
+		else
+		{
+			forEach(root, UIPropertyIds::Group, removeIds);
+		}
 
 		for (auto g : groupsToDelete)
 			g.getParent().removeChild(g, um);
@@ -954,14 +1081,27 @@ struct BuildHelpers
 
 			Array<ValueTree> connectionsToBeRemoved;
 
-			forEach(root, PropertyIds::Connection, [&](ValueTree& c)
+			if(auto ni = NetworkIndex::getFor(root))
 			{
-				if (nodeIds.contains(c[PropertyIds::NodeId].toString()))
-					connectionsToBeRemoved.add(c);
+				for(auto& id: nodeIds)
+					connectionsToBeRemoved.addArray(ni->dependencies.getConnectionsTo(id));
 
-				if(c.isAChildOf(vToBeDeleted))
-					connectionsToBeRemoved.add(c);
-			});
+				forEach(vToBeDeleted, PropertyIds::Connection, [&](ValueTree& c)
+				{
+					connectionsToBeRemoved.addIfNotAlreadyThere(c);
+				});
+			}
+			else
+			{
+				forEach(root, PropertyIds::Connection, [&](ValueTree& c)
+				{
+					if (nodeIds.contains(c[PropertyIds::NodeId].toString()))
+						connectionsToBeRemoved.add(c);
+
+					if(c.isAChildOf(vToBeDeleted))
+						connectionsToBeRemoved.add(c);
+				});
+			}
 
 			for(auto& c: connectionsToBeRemoved)
 			{
@@ -973,15 +1113,26 @@ struct BuildHelpers
 		}
 		else if (vToBeDeleted.getType() == PropertyIds::Connection)
 		{
-			auto path = ParameterHelpers::getParameterPath(vToBeDeleted);
+			auto path = ParameterHelpers::getParameterPathIds(vToBeDeleted);
 
-			if(ParameterHelpers::isNodeConnection(vToBeDeleted))
+			if(auto ni = NetworkIndex::getFor(root))
 			{
-				path = path.upToLastOccurrenceOf(".", false, false);
+				auto isNodeConnection = ParameterHelpers::isNodeConnection(vToBeDeleted);
+				auto pId = vToBeDeleted[PropertyIds::ParameterId].toString();
 
+				for(auto n: ni->dependencies.getNodes(vToBeDeleted[PropertyIds::NodeId].toString()))
+				{
+					if(isNodeConnection)
+						n.removeProperty(PropertyIds::Automated, um);
+					else
+						n.getChildWithName(PropertyIds::Parameters).getChildWithProperty(PropertyIds::ID, pId).removeProperty(PropertyIds::Automated, um);
+				}
+			}
+			else if(ParameterHelpers::isNodeConnection(vToBeDeleted))
+			{
 				forEach(root, PropertyIds::Node, [&](ValueTree& n)
 				{
-					if (n[PropertyIds::ID].toString() == path)
+					if (n[PropertyIds::ID] == path.first)
 						n.removeProperty(PropertyIds::Automated, um);
 				});
 
@@ -990,7 +1141,7 @@ struct BuildHelpers
 			{
 				forEach(root, PropertyIds::Parameter, [&](ValueTree& p)
 				{
-					if (ParameterHelpers::getParameterPath(p) == path)
+					if (ParameterHelpers::getParameterPathIds(p) == path)
 						p.removeProperty(PropertyIds::Automated, um);
 				});
 			}
@@ -1028,9 +1179,17 @@ struct BuildHelpers
 
 		std::map<String, String> changes;
 
-		StringArray internalParameterConnections;
+		// use the path table of the network so that the handles can be reused
+		NetworkIndex::PathTable localPaths;
+		auto ni = NetworkIndex::getFor(rootNode);
+		auto& paths = ni != nullptr ? ni->paths : localPaths;
+
+		std::unordered_set<NetworkIndex::PathTable::Handle> internalParameterConnections;
 		Array<ValueTree> connectionsToRemove;
 
+		// make sure that the new nodes don't get the same ID before they are added to the network
+		NetworkIndex::IdRegistry::ScopedBatch batch(rootNode);
+
 		for(auto& vToUpdate: nodesToUpdate)
 		{
 			updateIdsRecursive(rootNode, vToUpdate, changes);
@@ -1045,7 +1204,7 @@ struct BuildHelpers
 				if (changes.find(n) != changes.end())
 				{
 					c.setProperty(PropertyIds::NodeId, changes.at(n), nullptr);
-					internalParameterConnections.add(ParameterHelpers::getParameterPath(c));
+					internalParameterConnections.insert(paths.getHandle(c));
 				}
 				else
 					connectionsToRemove.add(c);
@@ -1061,7 +1220,7 @@ struct BuildHelpers
 			{
 				if (p[PropertyIds::Automated])
 				{
-					if (!internalParameterConnections.contains(ParameterHelpers::getParameterPath(p)))
+					if (internalParameterConnections.find(paths.getHandle(p)) == internalParameterConnections.end())
 						p.removeProperty(PropertyIds::Automated, nullptr);
 				}
 			});
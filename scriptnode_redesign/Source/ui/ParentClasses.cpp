@@ -233,9 +233,11 @@ NetworkParent::Map::Map(const ValueTree& v, NetworkParent& p_, Rectangle<int> vi
 
 	viewPosition = viewPosition_.toFloat().transformed(sc);
 
+	auto ni = NetworkIndex::getFor(v);
+
 	Helpers::forEachVisibleNode(v, [&](const ValueTree& n)
 		{
-			auto x = Helpers::getBoundsInRoot(n, false).toFloat();
+			auto x = (ni != nullptr ? ni->bounds.getBoundsInRoot(n, false) : Helpers::getBoundsInRoot(n, false)).toFloat();
 
 			if (n == v)
 				x = fullBounds;
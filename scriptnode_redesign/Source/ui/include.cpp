@@ -33,6 +33,7 @@
 #include "include.h"
 
 #include "Helpers.cpp"
+#include "NetworkIndex.cpp"
 #include "ComponentFactory.cpp"
 #include "NodeSubComponent.cpp"
 #include "NodeComponent.cpp"
@@ -35,6 +35,7 @@
 #include <JuceHeader.h>
 
 #include "Helpers.h"
+#include "NetworkIndex.h"
 #include "ComponentFactory.h"
 #include "NodeSubComponent.h"
 #include "NodeComponent.h"